@@ -0,0 +1,160 @@
+#include "Acronyms.h"
+#include <algorithm> // For std::transform
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>   // For std::stringstream
+
+std::string trim(const std::string& str) {
+    size_t first = str.find_first_not_of(' ');
+    if (first == std::string::npos) {
+        return std::string(); // Only spaces
+    }
+    size_t last = str.find_last_not_of(' ');
+    return str.substr(first, (last - first + 1));
+}
+
+namespace {
+    // Function to split a trailing ", [Tag Tag]" off a full name, returns false if there is none
+    bool splitTags(std::string& fullName, std::vector<std::string>& tags) {
+        size_t comma = fullName.find_last_of(',');
+        if (comma == std::string::npos) {
+            return false;
+        }
+
+        std::string field = trim(fullName.substr(comma + 1));
+        if (field.size() < 2 || field.front() != '[' || field.back() != ']') {
+            return false;
+        }
+
+        std::stringstream ss(field.substr(1, field.size() - 2));
+        std::string tag;
+        tags.clear();
+        while (ss >> tag) {
+            tags.push_back(tag);
+        }
+        fullName = trim(fullName.substr(0, comma));
+        return true;
+    }
+
+    // Function to split a trailing ", <weight>" off a full name, returns false if there is none
+    bool splitWeight(std::string& fullName, float& weight) {
+        size_t comma = fullName.find_last_of(',');
+        if (comma == std::string::npos) {
+            return false;
+        }
+
+        std::string field = trim(fullName.substr(comma + 1));
+        if (field.empty()) {
+            return false;
+        }
+        char* end = nullptr;
+        double value = std::strtod(field.c_str(), &end);
+        if (*end != '\0' || !std::isfinite(value) || value < 0) {
+            return false;
+        }
+
+        weight = static_cast<float>(value);
+        fullName = trim(fullName.substr(0, comma));
+        return true;
+    }
+}
+
+bool parseAcronymLine(const std::string& line, AcronymEntry& entry) {
+    std::stringstream ss(line);
+
+    // Split the line by the comma
+    if (!std::getline(ss, entry.acronym, ',') || !std::getline(ss, entry.fullName)) {
+        return false;
+    }
+    entry.acronym = trim(entry.acronym); // Trim any whitespace around the acronym
+    entry.fullName = trim(entry.fullName); // Trim any whitespace around the full name
+
+    // Convert acronym to uppercase for consistency
+    std::transform(entry.acronym.begin(), entry.acronym.end(), entry.acronym.begin(), ::toupper);
+
+    // Tags come last, so they are split off before the weight
+    entry.tags.clear();
+    entry.tagged = splitTags(entry.fullName, entry.tags);
+    entry.weight = 1.0f;
+    entry.weighted = splitWeight(entry.fullName, entry.weight);
+    return true;
+}
+
+AcronymMap loadAcronyms(const std::string& filename) {
+    AcronymWeights weights;
+    return loadAcronyms(filename, weights);
+}
+
+AcronymMap loadAcronyms(const std::string& filename, AcronymWeights& weights) {
+    AcronymTags tags;
+    return loadAcronyms(filename, weights, tags);
+}
+
+namespace {
+    // Function to add one parsed line to a deck; a later line replaces an earlier one completely
+    void addAcronymEntry(AcronymEntry& entry, AcronymMap& acronyms, AcronymWeights& weights, AcronymTags& tags) {
+        if (entry.tagged) {
+            tags[entry.acronym] = std::move(entry.tags);
+        }
+        else {
+            tags.erase(entry.acronym);
+        }
+        if (entry.weighted) {
+            weights[entry.acronym] = entry.weight;
+        }
+        else {
+            weights.erase(entry.acronym);
+        }
+        acronyms[entry.acronym] = std::move(entry.fullName); // Store in map
+    }
+}
+
+AcronymMap loadAcronyms(const std::string& filename, AcronymWeights& weights, AcronymTags& tags) {
+    AcronymMap acronyms;
+    weights.clear();
+    tags.clear();
+    std::ifstream file(filename);
+
+    if (!file) {
+        std::cerr << "Error: Unable to open file: " << filename << std::endl;
+        return acronyms;
+    }
+
+    std::string line;
+    AcronymEntry entry;
+    while (std::getline(file, line)) {
+        if (parseAcronymLine(line, entry)) {
+            addAcronymEntry(entry, acronyms, weights, tags);
+        }
+    }
+
+    return acronyms;
+}
+
+AcronymMap parseAcronyms(std::string_view text, AcronymWeights& weights, AcronymTags& tags) {
+    AcronymMap acronyms;
+    weights.clear();
+    tags.clear();
+
+    std::string line;
+    AcronymEntry entry;
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view next = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        // A file opened in text mode drops the \r of a Windows line ending, so it is dropped here too
+        if (!next.empty() && next.back() == '\r') {
+            next.remove_suffix(1);
+        }
+        line.assign(next.data(), next.size());
+        if (parseAcronymLine(line, entry)) {
+            addAcronymEntry(entry, acronyms, weights, tags);
+        }
+    }
+
+    return acronyms;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Acronym -> full name, keys are stored in upper case
+using AcronymMap = std::unordered_map<std::string, std::string>;
+
+// Acronym -> how often it should come up relative to the others; acronyms without an entry weigh 1
+using AcronymWeights = std::unordered_map<std::string, float>;
+
+// Acronym -> the categories it belongs to, e.g. "Crypto", as written in the file
+using AcronymTags = std::unordered_map<std::string, std::vector<std::string>>;
+
+// One line of a deck file, split into its fields
+struct AcronymEntry {
+    std::string acronym;
+    std::string fullName;
+    float weight = 1.0f;
+    bool weighted = false; // The line has a weight field
+    bool tagged = false;   // The line has a tag field
+    std::vector<std::string> tags;
+};
+
+// Helper function to trim whitespace from a string
+std::string trim(const std::string& str);
+
+// Function to split one line of a deck file into its fields, returns false if it has no comma
+bool parseAcronymLine(const std::string& line, AcronymEntry& entry);
+
+// Function to load acronyms from a file ("ACRONYM, Full Name" per line)
+AcronymMap loadAcronyms(const std::string& filename);
+
+// Function to load acronyms and their optional weights ("ACRONYM, Full Name, 2.5" per line).
+// Full names may contain commas, so the last field only counts as a weight if it is a number.
+AcronymMap loadAcronyms(const std::string& filename, AcronymWeights& weights);
+
+// Function to load acronyms, weights and tags ("ACRONYM, Full Name, 2.5, [Crypto Wireless]" per line).
+// Tags are an optional last field in square brackets, separated by spaces; the weight may precede them.
+AcronymMap loadAcronyms(const std::string& filename, AcronymWeights& weights, AcronymTags& tags);
+
+// Function to parse a deck that is already in memory, e.g. read from an asset archive, the same way
+// loadAcronyms() parses a file
+AcronymMap parseAcronyms(std::string_view text, AcronymWeights& weights, AcronymTags& tags);
@@ -0,0 +1,47 @@
+#include "AliasTable.h"
+
+void AliasTable::build(const std::vector<float>& weights) {
+    threshold.clear();
+    alias.clear();
+
+    double total = 0.0;
+    for (float weight : weights) {
+        total += weight > 0.0f ? weight : 0.0f;
+    }
+    if (total <= 0.0) {
+        return;
+    }
+
+    // Scale so the average weight is 1, then pair every under-full column with an over-full one
+    std::size_t count = weights.size();
+    std::vector<double> scaled(count);
+    std::vector<std::uint32_t> small;
+    std::vector<std::uint32_t> large;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        scaled[i] = (weights[i] > 0.0f ? weights[i] : 0.0f) * count / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    threshold.assign(count, 0xFFFFFFFFu);
+    alias.resize(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        alias[i] = i;
+    }
+
+    while (!small.empty() && !large.empty()) {
+        std::uint32_t less = small.back();
+        small.pop_back();
+        std::uint32_t more = large.back();
+
+        threshold[less] = static_cast<std::uint32_t>(scaled[less] * 4294967296.0);
+        alias[less] = more;
+
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // Whatever is left is full up to rounding error and always keeps its own index
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Weighted sampling with Vose's alias method.
+// Building the table is O(n); every draw then costs one index and one coin flip, O(1) however
+// skewed the weights are. Weights only need to be non-negative, they do not have to sum to one.
+// The coin is an integer threshold compared against raw generator output, so a seeded draw
+// sequence does not depend on floating point rounding.
+class AliasTable {
+public:
+    // Function to rebuild the table; if every weight is zero (or there are none) the table is empty
+    void build(const std::vector<float>& weights);
+
+    bool empty() const { return threshold.empty(); }
+    std::size_t size() const { return threshold.size(); }
+
+    // Function to draw an index with probability weight[i] / sum of weights
+    std::uint32_t draw(std::mt19937& rng) const {
+        std::uniform_int_distribution<std::uint32_t> indexDist(0, static_cast<std::uint32_t>(threshold.size() - 1));
+        std::uint32_t index = indexDist(rng);
+        return rng() < threshold[index] ? index : alias[index];
+    }
+
+private:
+    std::vector<std::uint32_t> threshold; // Keep index if rng() is below this, otherwise take alias
+    std::vector<std::uint32_t> alias;
+};
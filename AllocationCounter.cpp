@@ -0,0 +1,110 @@
+#include "AllocationCounter.h"
+
+#ifdef ALLOCATION_COUNTING
+namespace {
+    // Trivially constructed, so reading it from inside an allocation never allocates itself
+    thread_local std::uint64_t allocations = 0;
+}
+
+#ifdef _WIN32
+#include <crtdbg.h>
+
+namespace {
+    int countAllocation(int allocType, void*, size_t, int, long, const unsigned char*, int) {
+        if (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC) {
+            allocations++;
+        }
+        return 1; // Let the allocation go ahead
+    }
+
+    // Installed during static initialisation, before the game allocates anything worth counting
+    const _CRT_ALLOC_HOOK previousHook = _CrtSetAllocHook(countAllocation);
+}
+#else
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocations++;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+// Over-aligned types
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocations++;
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* memory = std::aligned_alloc(align, (size + align - 1) / align * align + (size == 0 ? align : 0))) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+std::uint64_t threadAllocationCount() {
+    return allocations;
+}
+#else
+std::uint64_t threadAllocationCount() {
+    return 0;
+}
+#endif
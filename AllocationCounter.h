@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocation counting, for checking that steady-state frames allocate nothing.
+// Debug builds count every allocation per thread: on Windows through the debug CRT's allocation
+// hook, which also sees the mallocs made inside the SFML DLLs since they share the debug CRT, and
+// elsewhere by replacing the global operator new. Release builds count nothing and pay nothing.
+#ifdef _DEBUG
+#define ALLOCATION_COUNTING
+constexpr bool allocationCountingEnabled = true;
+#else
+constexpr bool allocationCountingEnabled = false;
+#endif
+
+// Function to return how many heap allocations the calling thread has made; always 0 when not counting
+std::uint64_t threadAllocationCount();
@@ -0,0 +1,463 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char magic[4] = { 'A', 'I', 'P', 'K' };
+    const std::size_t headerBytes = 16;
+    const std::size_t tocEntryBytes = 32; // Without the name
+
+    // Shortest match worth a back-reference, and the farthest back one can reach
+    const std::size_t minMatch = 4;
+    const std::size_t maxOffset = 0xFFFF;
+    const int hashBits = 14;
+
+    template <typename T>
+    T readLittle(const unsigned char* bytes) {
+        T value = 0;
+        for (std::size_t i = sizeof(T); i-- > 0;) {
+            value = static_cast<T>((value << 8) | bytes[i]);
+        }
+        return value;
+    }
+
+    template <typename T>
+    void writeLittle(std::vector<unsigned char>& out, T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint32_t read32(const unsigned char* bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // Lengths that do not fit in a token nibble continue in bytes of 255 and a final smaller byte
+    void writeLength(std::vector<unsigned char>& out, std::size_t length) {
+        for (length -= 15; length >= 255; length -= 255) {
+            out.push_back(255);
+        }
+        out.push_back(static_cast<unsigned char>(length));
+    }
+
+    bool readLength(const unsigned char*& in, const unsigned char* end, std::size_t& length) {
+        unsigned char byte;
+        do {
+            if (in == end) {
+                return false;
+            }
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+
+    // Function to append one sequence: a token (literal count, match length - minMatch), the
+    // literals, then the match offset. The last sequence of a block has literals only.
+    void writeSequence(std::vector<unsigned char>& out, const unsigned char* literals, std::size_t literalCount,
+        std::size_t offset, std::size_t matchLength) {
+        std::size_t matchCode = matchLength ? matchLength - minMatch : 0;
+        out.push_back(static_cast<unsigned char>((std::min<std::size_t>(literalCount, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+        if (literalCount >= 15) {
+            writeLength(out, literalCount);
+        }
+        out.insert(out.end(), literals, literals + literalCount);
+        if (matchLength) {
+            writeLittle<std::uint16_t>(out, static_cast<std::uint16_t>(offset));
+            if (matchCode >= 15) {
+                writeLength(out, matchCode);
+            }
+        }
+    }
+
+    // Function to compress a block greedily, finding matches through a hash of the next four bytes
+    std::vector<unsigned char> compressBlock(const unsigned char* data, std::size_t size) {
+        std::vector<unsigned char> out;
+        out.reserve(size / 2);
+        std::vector<std::uint32_t> table(std::size_t(1) << hashBits, 0); // Position + 1, 0 when empty
+
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+        while (position + minMatch <= size) {
+            std::uint32_t sequence = read32(data + position);
+            std::uint32_t hash = (sequence * 2654435761u) >> (32 - hashBits);
+            std::size_t candidate = table[hash];
+            table[hash] = static_cast<std::uint32_t>(position + 1);
+
+            if (candidate && position - (candidate - 1) <= maxOffset && read32(data + candidate - 1) == sequence) {
+                std::size_t match = candidate - 1;
+                std::size_t length = minMatch;
+                while (position + length < size && data[match + length] == data[position + length]) {
+                    length++;
+                }
+                writeSequence(out, data + anchor, position - anchor, position - match, length);
+                position += length;
+                anchor = position;
+            }
+            else {
+                position++;
+            }
+        }
+        writeSequence(out, data + anchor, size - anchor, 0, 0);
+        return out;
+    }
+
+    // Function to inflate a block into exactly size bytes, returns false if the block is damaged
+    bool decompressBlock(const unsigned char* in, std::size_t storedSize, unsigned char* out, std::size_t size) {
+        const unsigned char* inEnd = in + storedSize;
+        std::size_t written = 0;
+        while (in < inEnd) {
+            unsigned char token = *in++;
+            std::size_t literalCount = token >> 4;
+            if (literalCount == 15 && !readLength(in, inEnd, literalCount)) {
+                return false;
+            }
+            if (literalCount > static_cast<std::size_t>(inEnd - in) || literalCount > size - written) {
+                return false;
+            }
+            std::memcpy(out + written, in, literalCount);
+            in += literalCount;
+            written += literalCount;
+            if (in == inEnd) {
+                break; // The last sequence
+            }
+
+            if (inEnd - in < 2) {
+                return false;
+            }
+            std::size_t offset = readLittle<std::uint16_t>(in);
+            in += 2;
+            std::size_t length = token & 15;
+            if (length == 15 && !readLength(in, inEnd, length)) {
+                return false;
+            }
+            length += minMatch;
+            if (offset == 0 || offset > written || length > size - written) {
+                return false;
+            }
+            // Byte by byte, since a match may overlap the bytes it is producing
+            const unsigned char* from = out + written - offset;
+            for (std::size_t i = 0; i < length; ++i) {
+                out[written + i] = from[i];
+            }
+            written += length;
+        }
+        return written == size;
+    }
+
+    bool readWholeFile(const std::filesystem::path& file, std::vector<unsigned char>& contents) {
+        std::ifstream in(file, std::ios::binary);
+        if (!in) {
+            return false;
+        }
+        in.seekg(0, std::ios::end);
+        std::streamoff length = in.tellg();
+        if (length < 0) {
+            return false;
+        }
+        contents.resize(static_cast<std::size_t>(length));
+        in.seekg(0, std::ios::beg);
+        return length == 0 || in.read(reinterpret_cast<char*>(contents.data()), length).good();
+    }
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& file) {
+    close();
+
+#if defined(_WIN32)
+    fileHandle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        return false;
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(fileHandle, &length) || length.QuadPart == 0) {
+        std::cerr << "Error: " << file << " is empty\n";
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        std::cerr << "Error: Unable to map " << file << "\n";
+        close();
+        return false;
+    }
+    base = static_cast<const unsigned char*>(view);
+    mappedBytes = static_cast<std::size_t>(length.QuadPart);
+#elif defined(__unix__) || defined(__APPLE__)
+    int descriptor = ::open(file.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        std::cerr << "Error: " << file << " is empty\n";
+        ::close(descriptor);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor); // The mapping keeps the file open
+    if (view == MAP_FAILED) {
+        std::cerr << "Error: Unable to map " << file << "\n";
+        return false;
+    }
+    base = static_cast<const unsigned char*>(view);
+    mappedBytes = static_cast<std::size_t>(status.st_size);
+#else
+    if (!readWholeFile(file, contents) || contents.empty()) {
+        contents.clear();
+        return false;
+    }
+    base = contents.data();
+    mappedBytes = contents.size();
+#endif
+
+    // Everything below is checked against the mapping, so a truncated or foreign file is refused
+    // here instead of being read out of bounds later
+    if (mappedBytes < headerBytes || std::memcmp(base, magic, sizeof(magic)) != 0) {
+        std::cerr << "Error: " << file << " is not an asset archive\n";
+        close();
+        return false;
+    }
+    std::uint32_t fileVersion = readLittle<std::uint32_t>(base + 4);
+    std::uint32_t count = readLittle<std::uint32_t>(base + 8);
+    std::uint32_t tocBytes = readLittle<std::uint32_t>(base + 12);
+    if (fileVersion != version) {
+        std::cerr << "Error: " << file << " is version " << fileVersion << ", expected " << version << "\n";
+        close();
+        return false;
+    }
+    if (tocBytes > mappedBytes - headerBytes) {
+        std::cerr << "Error: " << file << " is truncated\n";
+        close();
+        return false;
+    }
+
+    const unsigned char* toc = base + headerBytes;
+    const unsigned char* tocEnd = toc + tocBytes;
+    entries.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        if (static_cast<std::size_t>(tocEnd - toc) < tocEntryBytes) {
+            std::cerr << "Error: " << file << " has a damaged table of contents\n";
+            close();
+            return false;
+        }
+        Entry entry;
+        entry.offset = readLittle<std::uint64_t>(toc);
+        entry.storedSize = readLittle<std::uint64_t>(toc + 8);
+        entry.size = readLittle<std::uint64_t>(toc + 16);
+        entry.flags = readLittle<std::uint32_t>(toc + 24);
+        std::uint32_t nameLength = readLittle<std::uint32_t>(toc + 28);
+        toc += tocEntryBytes;
+        if (nameLength > static_cast<std::size_t>(tocEnd - toc)) {
+            std::cerr << "Error: " << file << " has a damaged table of contents\n";
+            close();
+            return false;
+        }
+        std::string name(reinterpret_cast<const char*>(toc), nameLength);
+        toc += nameLength;
+
+        bool compressed = (entry.flags & compressedFlag) != 0;
+        if (entry.offset > mappedBytes || entry.storedSize > mappedBytes - entry.offset ||
+            (entry.flags & ~compressedFlag) != 0 || (!compressed && entry.size != entry.storedSize)) {
+            std::cerr << "Error: " << file << " has a damaged entry " << name << "\n";
+            close();
+            return false;
+        }
+        entries[std::move(name)] = entry;
+    }
+    return true;
+}
+
+void AssetArchive::close() {
+    {
+        std::lock_guard<std::mutex> lock(inflateMutex);
+        inflated.clear();
+    }
+    entries.clear();
+
+#if defined(_WIN32)
+    if (base) {
+        UnmapViewOfFile(base);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+    if (base) {
+        munmap(const_cast<unsigned char*>(base), mappedBytes);
+    }
+#else
+    contents.clear();
+    contents.shrink_to_fit();
+#endif
+    base = nullptr;
+    mappedBytes = 0;
+}
+
+bool AssetArchive::read(const std::string& name, const void*& data, std::size_t& size) const {
+    auto it = entries.find(name);
+    if (it == entries.end()) {
+        return false;
+    }
+    const Entry& entry = it->second;
+    const unsigned char* stored = base + entry.offset;
+    if (!(entry.flags & compressedFlag)) {
+        data = stored;
+        size = static_cast<std::size_t>(entry.size);
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(inflateMutex);
+    auto& bytes = inflated[name];
+    if (!bytes) {
+        auto unpacked = std::make_unique<std::vector<unsigned char>>(static_cast<std::size_t>(entry.size));
+        if (!decompressBlock(stored, static_cast<std::size_t>(entry.storedSize), unpacked->data(), unpacked->size())) {
+            std::cerr << "Error: Archive entry " << name << " is damaged\n";
+            inflated.erase(name);
+            return false;
+        }
+        bytes = std::move(unpacked);
+    }
+    data = bytes->data();
+    size = bytes->size();
+    return true;
+}
+
+bool AssetArchive::readText(const std::string& name, std::string_view& text) const {
+    const void* data = nullptr;
+    std::size_t size = 0;
+    if (!read(name, data, size)) {
+        return false;
+    }
+    text = std::string_view(static_cast<const char*>(data), size);
+    return true;
+}
+
+bool writeAssetArchive(const std::string& archiveFile, const std::string& root,
+    const std::vector<std::string>& paths, bool compress, std::ostream& log) {
+    // Collect the files, a directory's in name order so the same tree always packs the same way
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (const std::string& path : paths) {
+        std::filesystem::path full = std::filesystem::path(root) / path;
+        if (!std::filesystem::is_directory(full, error)) {
+            files.push_back(full);
+            continue;
+        }
+        std::vector<std::filesystem::path> directoryFiles;
+        for (std::filesystem::recursive_directory_iterator it(full, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file()) {
+                directoryFiles.push_back(it->path());
+            }
+        }
+        std::sort(directoryFiles.begin(), directoryFiles.end());
+        files.insert(files.end(), directoryFiles.begin(), directoryFiles.end());
+    }
+
+    struct Packed {
+        std::string name;
+        std::vector<unsigned char> stored;
+        std::uint64_t size = 0;
+        std::uint32_t flags = 0;
+    };
+    std::vector<Packed> packed;
+    packed.reserve(files.size());
+    std::size_t tocBytes = 0;
+    for (const std::filesystem::path& file : files) {
+        Packed entry;
+        entry.name = std::filesystem::relative(file, root, error).generic_string();
+        if (error || entry.name.empty()) {
+            entry.name = file.generic_string();
+        }
+        if (!readWholeFile(file, entry.stored)) {
+            std::cerr << "Error: Unable to read " << file.string() << "\n";
+            return false;
+        }
+        entry.size = entry.stored.size();
+        if (compress && !entry.stored.empty()) {
+            std::vector<unsigned char> compressed = compressBlock(entry.stored.data(), entry.stored.size());
+            if (compressed.size() <= entry.stored.size() - entry.stored.size() / 8) {
+                entry.stored = std::move(compressed);
+                entry.flags |= AssetArchive::compressedFlag;
+            }
+        }
+        log << "  " << entry.name << ": " << entry.size << " bytes";
+        if (entry.flags & AssetArchive::compressedFlag) {
+            log << ", compressed to " << entry.stored.size();
+        }
+        log << "\n";
+        tocBytes += tocEntryBytes + entry.name.size();
+        packed.push_back(std::move(entry));
+    }
+
+    // Header and table of contents, with every entry's offset rounded up to the alignment
+    auto align = [](std::uint64_t offset) {
+        return (offset + AssetArchive::entryAlignment - 1) / AssetArchive::entryAlignment * AssetArchive::entryAlignment;
+    };
+    std::vector<unsigned char> head;
+    head.reserve(headerBytes + tocBytes);
+    head.insert(head.end(), magic, magic + sizeof(magic));
+    writeLittle<std::uint32_t>(head, AssetArchive::version);
+    writeLittle<std::uint32_t>(head, static_cast<std::uint32_t>(packed.size()));
+    writeLittle<std::uint32_t>(head, static_cast<std::uint32_t>(tocBytes));
+    std::uint64_t offset = align(headerBytes + tocBytes);
+    for (const Packed& entry : packed) {
+        writeLittle<std::uint64_t>(head, offset);
+        writeLittle<std::uint64_t>(head, entry.stored.size());
+        writeLittle<std::uint64_t>(head, entry.size);
+        writeLittle<std::uint32_t>(head, entry.flags);
+        writeLittle<std::uint32_t>(head, static_cast<std::uint32_t>(entry.name.size()));
+        head.insert(head.end(), entry.name.begin(), entry.name.end());
+        offset = align(offset + entry.stored.size());
+    }
+
+    std::ofstream out(archiveFile, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Error: Unable to write " << archiveFile << "\n";
+        return false;
+    }
+    const char padding[AssetArchive::entryAlignment] = {};
+    out.write(reinterpret_cast<const char*>(head.data()), head.size());
+    std::uint64_t written = head.size();
+    for (const Packed& entry : packed) {
+        out.write(padding, static_cast<std::streamsize>(align(written) - written));
+        out.write(reinterpret_cast<const char*>(entry.stored.data()), entry.stored.size());
+        written = align(written) + entry.stored.size();
+    }
+    out.write(padding, static_cast<std::streamsize>(align(written) - written)); // Keeps a trailing empty entry inside the file
+    written = align(written);
+    if (!out.flush()) {
+        std::cerr << "Error: Unable to write " << archiveFile << "\n";
+        return false;
+    }
+    log << "Packed " << packed.size() << " files into " << archiveFile << " (" << written << " bytes)\n";
+    return true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// A read-only, memory-mapped pack of game assets, so the game opens one file at start instead of
+// one per texture, font and deck.
+//
+// Layout, all numbers little-endian:
+//   header  "AIPK", version, entry count, table of contents size (four u32)
+//   table   per entry: offset, stored size, size (u64), flags, name length (u32), name bytes
+//   data    each entry starts on an entryAlignment boundary
+// Names are the paths the game asks for, with forward slashes ("Fonts/arial.ttf"). An entry with
+// the compressed flag holds an LZ77 block that inflates to size bytes; the others are stored as
+// they are and read straight out of the mapping, with no copy.
+class AssetArchive {
+public:
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint32_t compressedFlag = 1;
+    static constexpr std::size_t entryAlignment = 64;
+
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    // Function to map an archive and read its table of contents, returns false if it is missing or damaged
+    bool open(const std::string& file);
+
+    // Function to unmap the archive; pointers handed out by read() become invalid
+    void close();
+
+    bool isOpen() const { return base != nullptr; }
+    std::size_t size() const { return entries.size(); }
+    bool contains(const std::string& name) const { return entries.count(name) != 0; }
+
+    // Function to get the bytes of an entry. Stored entries point into the mapping, compressed ones
+    // are inflated on first use and kept, so the pointer stays valid until the archive is closed.
+    // Safe to call from several threads.
+    bool read(const std::string& name, const void*& data, std::size_t& size) const;
+
+    // Function to get a text entry, e.g. a deck
+    bool readText(const std::string& name, std::string_view& text) const;
+
+private:
+    struct Entry {
+        std::uint64_t offset = 0;
+        std::uint64_t storedSize = 0;
+        std::uint64_t size = 0;
+        std::uint32_t flags = 0;
+    };
+
+    const unsigned char* base = nullptr;
+    std::size_t mappedBytes = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;    // HANDLE, kept as void* so this header does not pull in Windows.h
+    void* mappingHandle = nullptr;
+#elif !defined(__unix__) && !defined(__APPLE__)
+    std::vector<unsigned char> contents; // No mmap: the whole file is read instead
+#endif
+
+    std::unordered_map<std::string, Entry> entries;
+
+    mutable std::mutex inflateMutex;
+    mutable std::unordered_map<std::string, std::unique_ptr<std::vector<unsigned char>>> inflated;
+};
+
+// Function to pack files into an archive. Each file is stored under its path relative to root with
+// forward slashes; directories are packed recursively. Entries are compressed when compress is set
+// and that saves at least an eighth of the file. Returns false if a file cannot be read or the
+// archive cannot be written.
+bool writeAssetArchive(const std::string& archiveFile, const std::string& root,
+    const std::vector<std::string>& paths, bool compress, std::ostream& log);
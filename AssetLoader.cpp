@@ -0,0 +1,120 @@
+#include "AssetLoader.h"
+#include "EmbeddedAssets.h"
+#include <iostream>
+
+bool findAssetInMemory(const AssetArchive* archive, const std::string& file, const void*& data, std::size_t& size) {
+    return (archive && archive->read(file, data, size)) || findEmbeddedFile(file, data, size);
+}
+
+AssetLoader::AssetLoader(const AssetArchive* archive, unsigned threadCount)
+    : archive(archive), pool(threadCount) {
+}
+
+AssetLoader::~AssetLoader() {
+    pool.wait();
+}
+
+void AssetLoader::requestTexture(const std::string& file) {
+    if (!requested.insert(file).second) {
+        return;
+    }
+    pool.submit([this, file]() {
+        auto image = std::make_unique<sf::Image>();
+        const void* data = nullptr;
+        std::size_t size = 0;
+        bool loaded = findAssetInMemory(archive, file, data, size) ? image->loadFromMemory(data, size) : image->loadFromFile(file);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (loaded) {
+            decodedImages.emplace_back(file, std::move(image));
+        }
+        else {
+            failedFiles.push_back(file);
+        }
+    });
+}
+
+void AssetLoader::requestFont(const std::string& file) {
+    if (!requested.insert(file).second) {
+        return;
+    }
+    pool.submit([this, file]() {
+        auto font = std::make_unique<sf::Font>();
+        const void* data = nullptr;
+        std::size_t size = 0;
+        bool loaded = findAssetInMemory(archive, file, data, size) ? font->loadFromMemory(data, size) : font->loadFromFile(file);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (loaded) {
+            loadedFonts.emplace_back(file, std::move(font));
+        }
+        else {
+            failedFiles.push_back(file);
+        }
+    });
+}
+
+void AssetLoader::update(int maxUploads) {
+    std::vector<std::pair<std::string, std::unique_ptr<sf::Image>>> uploads;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!decodedImages.empty() && static_cast<int>(uploads.size()) < maxUploads) {
+            uploads.push_back(std::move(decodedImages.front()));
+            decodedImages.pop_front();
+        }
+        while (!loadedFonts.empty()) {
+            fonts[loadedFonts.front().first] = std::move(loadedFonts.front().second);
+            loadedFonts.pop_front();
+        }
+        for (const std::string& file : failedFiles) {
+            std::cerr << "Error loading " << file << "\n";
+            failures.insert(file);
+        }
+        failedFiles.clear();
+    }
+
+    // Uploading is the part that needs the window's GL context, so it happens outside the lock
+    for (auto& upload : uploads) {
+        auto texture = std::make_unique<sf::Texture>();
+        if (texture->loadFromImage(*upload.second)) {
+            textures[upload.first] = std::move(texture);
+        }
+        else {
+            std::cerr << "Error creating a texture for " << upload.first << "\n";
+            failures.insert(upload.first);
+        }
+    }
+}
+
+const sf::Texture* AssetLoader::texture(const std::string& file) const {
+    auto it = textures.find(file);
+    return it != textures.end() ? it->second.get() : nullptr;
+}
+
+const sf::Font* AssetLoader::font(const std::string& file) const {
+    auto it = fonts.find(file);
+    return it != fonts.end() ? it->second.get() : nullptr;
+}
+
+bool AssetLoader::ready(const std::vector<std::string>& files) const {
+    for (const std::string& file : files) {
+        if (!textures.count(file) && !fonts.count(file)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool AssetLoader::failed(const std::vector<std::string>& files) const {
+    for (const std::string& file : files) {
+        if (failures.count(file)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+float AssetLoader::progress() const {
+    if (requested.empty()) {
+        return 1.0f;
+    }
+    return static_cast<float>(textures.size() + fonts.size() + failures.size()) / requested.size();
+}
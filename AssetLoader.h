@@ -0,0 +1,73 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "AssetArchive.h"
+#include "WorkStealingPool.h"
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Function to find a file in the archive (if there is one) or else the executable, false if it has to come from disk
+bool findAssetInMemory(const AssetArchive* archive, const std::string& file, const void*& data, std::size_t& size);
+
+// Loads textures and fonts in the background so the window keeps drawing while they come in.
+//
+// Images are decoded into sf::Image and fonts are opened on worker threads. Creating a texture has
+// to happen on the thread that owns the window, so decoded images wait in a queue until update()
+// uploads them, a few per frame, so one frame never stalls on all of them at once. Assets are
+// loaded once and kept for the whole session; they are looked up by file name.
+//
+// Files found in the asset archive, or else compiled into the executable (EmbeddedAssets.h), are
+// decoded straight from memory with loadFromMemory; the others are read from disk as loose files.
+// Fonts keep reading the memory they were loaded from, so the archive has to outlive the loader.
+class AssetLoader {
+public:
+    explicit AssetLoader(const AssetArchive* archive = nullptr, unsigned threadCount = 2);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Functions to start loading a file; asking again for a file already requested does nothing
+    void requestTexture(const std::string& file);
+    void requestFont(const std::string& file);
+
+    // Function to upload up to maxUploads decoded images to textures; call once per frame from the
+    // thread that owns the window
+    void update(int maxUploads = 2);
+
+    // Functions to look up a loaded asset, nullptr while it is still loading or if it failed
+    const sf::Texture* texture(const std::string& file) const;
+    const sf::Font* font(const std::string& file) const;
+
+    // Function to check whether every listed file is loaded
+    bool ready(const std::vector<std::string>& files) const;
+
+    // Function to check whether any listed file failed to load
+    bool failed(const std::vector<std::string>& files) const;
+
+    // Fraction of the requested assets that are loaded or failed, for a progress bar
+    float progress() const;
+
+private:
+    const AssetArchive* archive;
+
+    // Owned by the window thread
+    std::unordered_set<std::string> requested;
+    std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures;
+    std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts;
+    std::unordered_set<std::string> failures;
+
+    // Handed over from the workers
+    std::mutex mutex;
+    std::deque<std::pair<std::string, std::unique_ptr<sf::Image>>> decodedImages;
+    std::deque<std::pair<std::string, std::unique_ptr<sf::Font>>> loadedFonts;
+    std::vector<std::string> failedFiles;
+
+    // Declared last so the workers finish before anything they write to is destroyed
+    WorkStealingPool pool;
+};
@@ -0,0 +1,223 @@
+// Asset packer.
+// Packs the game's textures, fonts and default deck into one archive (AssetArchive), so the game
+// opens a single file at start. Run it from the game directory after changing an asset; the game
+// falls back to the loose files while there is no archive.
+//
+// With --embed it writes a C++ source instead, compiled into Release builds (EmbeddedAssets.h): the
+// default fonts and textures as constexpr byte arrays and the deck split into its fields, so the
+// executable needs no files at all. The source is only rewritten when its contents change, so an
+// unchanged asset does not trigger a rebuild.
+//
+// Usage: "Asset Packer.exe" [--out FILE] [--root DIR] [--no-compress] [PATH...]
+//        "Asset Packer.exe" --embed FILE [--root DIR] [--deck FILE] [PATH...]
+//        PATH defaults to Textures, Fonts and acronyms.txt when packing, and to the files the game
+//        loads by default when embedding; paths are relative to --root
+#include "Acronyms.h"
+#include "AssetArchive.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    // The files the game loads at start (see Source.cpp)
+    const std::vector<std::string> defaultEmbeddedFiles = {
+        "Fonts/gyparody hv.ttf", "Fonts/arial.ttf", "Textures/background.jpg",
+        "Textures/1.png", "Textures/2.png", "Textures/3.png", "Textures/4.png"
+    };
+
+    // Function to write text as a C++ string literal. Anything but plain printable ASCII is written
+    // as a three-digit octal escape, which, unlike a hex escape, cannot swallow the next character.
+    void writeLiteral(std::ostream& out, std::string_view text) {
+        out << '"';
+        for (char c : text) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\' || c == '?' || byte < 0x20 || byte >= 0x7F) {
+                out << '\\' << static_cast<char>('0' + (byte >> 6)) << static_cast<char>('0' + ((byte >> 3) & 7))
+                    << static_cast<char>('0' + (byte & 7));
+            }
+            else {
+                out << c;
+            }
+        }
+        out << "\"sv";
+    }
+
+    // Function to read a deck the way loadAcronyms() does, keeping every acronym where it first
+    // appears but with the fields of the last line that defines it
+    bool readDeckCards(const std::filesystem::path& deckFile, std::vector<AcronymEntry>& cards) {
+        std::ifstream file(deckFile);
+        if (!file) {
+            std::cerr << "Error: Unable to open file: " << deckFile.string() << "\n";
+            return false;
+        }
+        std::unordered_map<std::string, std::size_t> positions;
+        std::string line;
+        AcronymEntry entry;
+        while (std::getline(file, line)) {
+            if (!parseAcronymLine(line, entry)) {
+                continue;
+            }
+            auto found = positions.find(entry.acronym);
+            if (found != positions.end()) {
+                cards[found->second] = entry;
+            }
+            else {
+                positions.emplace(entry.acronym, cards.size());
+                cards.push_back(entry);
+            }
+        }
+        return true;
+    }
+
+    // Function to generate the source of EmbeddedAssets; returns false if a file cannot be read
+    bool writeEmbeddedSource(const std::string& sourceFile, const std::string& root, const std::vector<std::string>& files,
+        const std::string& deckFile, std::ostream& log) {
+        std::ostringstream out;
+        out << "// Generated by \"Asset Packer --embed\"; edit the assets instead and rebuild.\n"
+            << "#include \"EmbeddedAssets.h\"\n\n"
+            << "#if defined(EMBED_ASSETS)\n"
+            << "using namespace std::string_view_literals;\n\n"
+            << "namespace {\n";
+
+        std::size_t totalBytes = 0;
+        for (std::size_t index = 0; index < files.size(); ++index) {
+            std::ifstream in(std::filesystem::path(root) / files[index], std::ios::binary);
+            if (!in) {
+                std::cerr << "Error: Unable to read " << files[index] << "\n";
+                return false;
+            }
+            std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            totalBytes += bytes.size();
+
+            out << "    // " << files[index] << "\n"
+                << "    constexpr unsigned char file" << index << "[] = {";
+            for (std::size_t i = 0; i < bytes.size(); ++i) {
+                out << (i % 32 == 0 ? "\n        " : "") << static_cast<unsigned>(static_cast<unsigned char>(bytes[i])) << ',';
+            }
+            out << (bytes.empty() ? " 0 };\n" : "\n    };\n");
+            out << "    constexpr std::size_t file" << index << "Size = " << bytes.size() << ";\n\n";
+        }
+
+        out << "    constexpr EmbeddedFile files[] = {\n";
+        for (std::size_t index = 0; index < files.size(); ++index) {
+            out << "        { ";
+            writeLiteral(out, files[index]);
+            out << ", file" << index << ", file" << index << "Size },\n";
+        }
+        out << "    };\n";
+
+        std::vector<AcronymEntry> cards;
+        if (!deckFile.empty() && !readDeckCards(std::filesystem::path(root) / deckFile, cards)) {
+            return false;
+        }
+        std::vector<std::string> tags;
+        if (!cards.empty()) {
+            out << "\n    constexpr EmbeddedCard cards[] = {\n";
+            out << std::showpoint << std::setprecision(9);
+            for (const AcronymEntry& card : cards) {
+                out << "        { ";
+                writeLiteral(out, card.acronym);
+                out << ", ";
+                writeLiteral(out, card.fullName);
+                out << ", " << card.weight << "f, " << (card.weighted ? "true" : "false") << ", "
+                    << (card.tagged ? "true" : "false") << ", " << tags.size() << ", " << card.tags.size() << " },\n";
+                tags.insert(tags.end(), card.tags.begin(), card.tags.end());
+            }
+            out << "    };\n";
+        }
+        out << "\n    constexpr std::string_view tags[] = {"; // Never empty, an empty array would not compile
+        if (tags.empty()) {
+            out << " std::string_view()";
+        }
+        for (const std::string& tag : tags) {
+            out << "\n        ";
+            writeLiteral(out, tag);
+            out << ',';
+        }
+        out << (tags.empty() ? " };\n" : "\n    };\n");
+        out << "}\n\n";
+
+        out << "const EmbeddedAssets embeddedAssets = { files, " << files.size() << ", ";
+        writeLiteral(out, cards.empty() ? std::string() : deckFile);
+        out << ", " << (cards.empty() ? "nullptr" : "cards") << ", " << cards.size() << ", tags };\n"
+            << "#endif\n";
+
+        // Leave the file alone when nothing changed, so the build does not recompile it
+        std::string source = out.str();
+        std::ifstream existing(sourceFile, std::ios::binary);
+        std::string previous((std::istreambuf_iterator<char>(existing)), std::istreambuf_iterator<char>());
+        if (previous == source) {
+            log << sourceFile << " is up to date\n";
+            return true;
+        }
+        std::ofstream written(sourceFile, std::ios::binary | std::ios::trunc);
+        if (!written.write(source.data(), source.size()).flush()) {
+            std::cerr << "Error: Unable to write " << sourceFile << "\n";
+            return false;
+        }
+        log << "Embedded " << files.size() << " files (" << totalBytes << " bytes) and " << cards.size()
+            << " cards into " << sourceFile << "\n";
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string archiveFile = "assets.pak";
+    std::string embedFile;
+    std::string deckFile = "acronyms.txt";
+    std::string root = ".";
+    bool compress = true;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            archiveFile = argv[++i];
+        }
+        else if (arg == "--embed" && i + 1 < argc) {
+            embedFile = argv[++i];
+        }
+        else if (arg == "--deck" && i + 1 < argc) {
+            deckFile = argv[++i];
+        }
+        else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        }
+        else if (arg == "--no-compress") {
+            compress = false;
+        }
+        else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+        else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (!embedFile.empty()) {
+        return writeEmbeddedSource(embedFile, root, paths.empty() ? defaultEmbeddedFiles : paths, deckFile, std::cout) ? 0 : 1;
+    }
+
+    if (paths.empty()) {
+        paths = { "Textures", "Fonts", "acronyms.txt" };
+    }
+
+    if (!writeAssetArchive(archiveFile, root, paths, compress, std::cout)) {
+        return 1;
+    }
+
+    // Read the archive back so a damaged one is caught here rather than by the game
+    AssetArchive archive;
+    if (!archive.open(archiveFile)) {
+        return 1;
+    }
+    std::cout << "Verified " << archive.size() << " entries\n";
+    return 0;
+}
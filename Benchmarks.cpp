@@ -0,0 +1,488 @@
+// Micro-benchmarks for the game's hot paths.
+// Every benchmark runs its operation in batches large enough to time reliably and reports the
+// per-operation time of the fastest, median and 99th percentile batch. Results are written as
+// JSON; a previous results file can be kept as a baseline and compared against later runs.
+//
+// Usage: Benchmarks.exe [--filter TEXT] [--samples N] [--out FILE]
+//                       [--compare BASELINE] [--threshold PERCENT]
+//
+// Compare mode prints the median change per benchmark, marks every benchmark that got slower
+// by more than the threshold (10% by default) as a regression and exits with code 1 if any did.
+#include "Acronyms.h"
+#include "GameSimulation.h"
+#include "FrontCodedDictionary.h"
+#include "HighScores.h"
+#include "InternedDeck.h"
+#include "Leaderboard.h"
+#include "ParticleSystem.h"
+#include "QuestionScheduler.h"
+#include "RoundScene.h"
+#include "ShuffledDeck.h"
+#include "TagIndex.h"
+#include "TextLayout.h"
+#include <sqlite3.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct BenchmarkOptions {
+        std::string filter;
+        int samples = 100;
+        std::string outputFile = "benchmark_results.json";
+        std::string baselineFile;
+        double thresholdPercent = 10.0;
+    };
+
+    struct BenchmarkResult {
+        std::string name;
+        int samples = 0;
+        std::size_t opsPerSample = 0;
+        double minNanos = 0;
+        double medianNanos = 0;
+        double p99Nanos = 0;
+    };
+
+    const std::string benchmarkDatabase = "benchmark.db";
+    const int seededScoreRows = 10000;
+    const std::size_t scheduledDeckSize = 1000000;
+    const std::int64_t minSampleNanos = 50000; // Batches shorter than this are dominated by timer overhead
+
+    // Results of the benchmarked calls are added here so the optimizer cannot drop them
+    volatile std::size_t benchmarkSink = 0;
+
+    std::int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    template <typename Operation>
+    std::int64_t timeBatch(Operation& operation, std::size_t& next, std::size_t count) {
+        std::int64_t start = nowNanos();
+        for (std::size_t i = 0; i < count; ++i) {
+            operation(next++);
+        }
+        return nowNanos() - start;
+    }
+
+    // Function to time operation(i) for increasing i; the batch size doubles until one batch
+    // takes at least minSampleNanos, then that many operations are timed per sample
+    template <typename Operation>
+    BenchmarkResult runBenchmark(const std::string& name, int samples, Operation operation) {
+        std::size_t next = 0;
+        std::size_t batch = 1;
+        while (timeBatch(operation, next, batch) < minSampleNanos && batch < (std::size_t(1) << 24)) {
+            batch *= 2;
+        }
+
+        std::vector<double> perOp;
+        perOp.reserve(samples);
+        for (int i = 0; i < samples; ++i) {
+            perOp.push_back(static_cast<double>(timeBatch(operation, next, batch)) / batch);
+        }
+        std::sort(perOp.begin(), perOp.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.samples = samples;
+        result.opsPerSample = batch;
+        result.minNanos = perOp.front();
+        result.medianNanos = perOp[perOp.size() / 2];
+        result.p99Nanos = perOp[std::min(perOp.size() - 1, (perOp.size() * 99 + 99) / 100 - 1)];
+        return result;
+    }
+
+    // Function to create a fresh score database with seededScoreRows rows in one transaction
+    bool seedDatabase() {
+        std::remove(benchmarkDatabase.c_str());
+        setDatabasePath(benchmarkDatabase);
+        initializeDatabase();
+
+        sqlite3* db;
+        if (sqlite3_open(benchmarkDatabase.c_str(), &db) != SQLITE_OK) {
+            std::cerr << "Can't open database: " << sqlite3_errmsg(db) << "\n";
+            sqlite3_close(db);
+            return false;
+        }
+
+        sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+        sqlite3_stmt* stmt;
+        sqlite3_prepare_v2(db, "INSERT INTO HighScores (player_name, score) VALUES (?, ?);", -1, &stmt, nullptr);
+        for (int i = 0; i < seededScoreRows; ++i) {
+            std::string name = "Seed " + std::to_string(i);
+            sqlite3_bind_text(stmt, 1, name.c_str(), -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(stmt, 2, (i * 7919) % 20000 - 2000);
+            sqlite3_step(stmt);
+            sqlite3_reset(stmt);
+        }
+        sqlite3_finalize(stmt);
+        bool ok = sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr) == SQLITE_OK;
+        sqlite3_close(db);
+
+        if (!ok) {
+            std::cerr << "Error seeding " << benchmarkDatabase << "\n";
+        }
+        return ok;
+    }
+
+    // Function to read the switches, returns false on a malformed argument
+    bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            }
+            else if (arg == "--samples" && hasValue) {
+                options.samples = std::atoi(argv[++i]);
+            }
+            else if (arg == "--out" && hasValue) {
+                options.outputFile = argv[++i];
+            }
+            else if (arg == "--compare" && hasValue) {
+                options.baselineFile = argv[++i];
+            }
+            else if (arg == "--threshold" && hasValue) {
+                options.thresholdPercent = std::atof(argv[++i]);
+            }
+            else {
+                std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+                return false;
+            }
+        }
+
+        if (options.samples <= 0 || options.thresholdPercent <= 0) {
+            std::cerr << "--samples and --threshold must be positive\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool writeResults(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+        std::ofstream file(filename);
+        if (!file) {
+            std::cerr << "Error: Unable to write benchmark results: " << filename << std::endl;
+            return false;
+        }
+
+        // One benchmark per line keeps diffs between result files readable
+        file << std::fixed << std::setprecision(1) << "{\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            file << "    {\"name\": \"" << r.name << "\", \"samples\": " << r.samples << ", \"ops_per_sample\": " << r.opsPerSample
+                << ", \"min_ns\": " << r.minNanos << ", \"median_ns\": " << r.medianNanos << ", \"p99_ns\": " << r.p99Nanos << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    // Function to read the median of every benchmark from a results file written by writeResults
+    bool readBaseline(const std::string& filename, std::map<std::string, double>& medians) {
+        std::ifstream file(filename);
+        if (!file) {
+            std::cerr << "Error: Unable to open baseline: " << filename << std::endl;
+            return false;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const std::string nameKey = "\"name\": \"";
+        const std::string medianKey = "\"median_ns\": ";
+        std::size_t pos = 0;
+        while ((pos = text.find(nameKey, pos)) != std::string::npos) {
+            pos += nameKey.size();
+            std::size_t nameEnd = text.find('"', pos);
+            std::size_t medianPos = text.find(medianKey, nameEnd);
+            if (nameEnd == std::string::npos || medianPos == std::string::npos) {
+                break;
+            }
+            medians[text.substr(pos, nameEnd - pos)] = std::atof(text.c_str() + medianPos + medianKey.size());
+            pos = medianPos;
+        }
+
+        if (medians.empty()) {
+            std::cerr << "Error: No benchmarks found in baseline: " << filename << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    // Function to print the change against the baseline, returns the number of regressions
+    int compareResults(const std::vector<BenchmarkResult>& results, const std::map<std::string, double>& baseline, double thresholdPercent) {
+        int regressions = 0;
+        std::cout << "\nCompared to baseline (threshold " << thresholdPercent << "%):\n";
+        for (const BenchmarkResult& r : results) {
+            auto it = baseline.find(r.name);
+            std::cout << "  " << std::left << std::setw(32) << r.name << std::right;
+            if (it == baseline.end() || it->second <= 0) {
+                std::cout << "not in baseline\n";
+                continue;
+            }
+
+            double changePercent = (r.medianNanos / it->second - 1.0) * 100.0;
+            std::cout << std::fixed << std::setprecision(1) << std::setw(10) << it->second << " -> " << std::setw(10) << r.medianNanos
+                << " ns  " << std::showpos << changePercent << std::noshowpos << "%";
+            if (changePercent > thresholdPercent) {
+                std::cout << "  REGRESSION";
+                regressions++;
+            }
+            else if (changePercent < -thresholdPercent) {
+                std::cout << "  improved";
+            }
+            std::cout << "\n";
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!options.baselineFile.empty() && !readBaseline(options.baselineFile, baseline)) {
+        return 1;
+    }
+
+    AcronymMap acronyms = loadAcronyms("acronyms.txt");
+    if (acronyms.empty()) {
+        std::cerr << "acronyms.txt is missing or empty\n";
+        return 1;
+    }
+    if (!seedDatabase()) {
+        return 1;
+    }
+
+    sf::Font font;
+    if (!font.loadFromFile("Fonts/arial.ttf")) {
+        std::cerr << "Error loading font\n";
+        return 1;
+    }
+
+    // Inputs shared by several benchmarks
+    std::vector<std::string> keys;
+    std::vector<std::string> rawFields;
+    for (const auto& entry : acronyms) {
+        keys.push_back(entry.first);
+        rawFields.push_back("  " + entry.second + " ");
+    }
+
+    std::vector<BenchmarkResult> results;
+    auto run = [&](const std::string& name, auto operation) {
+        if (name.find(options.filter) == std::string::npos) {
+            return;
+        }
+        results.push_back(runBenchmark(name, options.samples, operation));
+        const BenchmarkResult& r = results.back();
+        std::cout << std::left << std::setw(32) << r.name << std::right << std::fixed << std::setprecision(1)
+            << "min " << std::setw(10) << r.minNanos << " ns   median " << std::setw(10) << r.medianNanos
+            << " ns   p99 " << std::setw(10) << r.p99Nanos << " ns\n";
+    };
+
+    run("trim", [&](std::size_t i) {
+        benchmarkSink += trim(rawFields[i % rawFields.size()]).size();
+    });
+
+    run("loadAcronyms", [&](std::size_t) {
+        benchmarkSink += loadAcronyms("acronyms.txt").size();
+    });
+
+    GameState game;
+    startGame(game, 1, acronyms, std::vector<sf::Vector2f>(), sf::Vector2f(800, 600), 1);
+
+    run("acronymLookup.hit", [&](std::size_t i) {
+        game.userInput = keys[i % keys.size()];
+        benchmarkSink += isCorrectAnswer(game, acronyms);
+    });
+
+    run("acronymLookup.miss", [&](std::size_t i) {
+        game.userInput = keys[i % keys.size()];
+        game.userInput += 'X';
+        benchmarkSink += isCorrectAnswer(game, acronyms);
+    });
+
+    run("selectRandomAcronym", [&](std::size_t) {
+        selectRandomAcronym(game, acronyms);
+        benchmarkSink += game.questionText.size();
+    });
+
+    // The game draws through the scheduler; give the deck skewed weights so the alias table is used
+    AcronymWeights weights;
+    std::vector<float> weightList;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        weights[keys[i]] = 1.0f + static_cast<float>(i % 7);
+        weightList.push_back(weights[keys[i]]);
+    }
+    QuestionScheduler deckScheduler(acronyms, weights);
+    GameState scheduledGame;
+    startGame(scheduledGame, 1, acronyms, std::vector<sf::Vector2f>(), sf::Vector2f(800, 600), 1, &deckScheduler);
+
+    run("selectRandomAcronym.scheduled", [&](std::size_t) {
+        selectRandomAcronym(scheduledGame, acronyms);
+        benchmarkSink += scheduledGame.questionText.size();
+    });
+
+    AliasTable aliasTable;
+    aliasTable.build(weightList);
+    std::mt19937 aliasRng(1);
+
+    run("aliasTable.draw", [&](std::size_t) {
+        benchmarkSink += aliasTable.draw(aliasRng);
+    });
+
+    // Mode 2 upper-cases the full name on every Enter
+    GameState termGame;
+    startGame(termGame, 2, acronyms, std::vector<sf::Vector2f>(), sf::Vector2f(800, 600), 1);
+    std::vector<std::string> fullNames;
+    std::vector<std::string> upperNames;
+    for (const auto& entry : acronyms) {
+        std::string name = entry.second;
+        fullNames.push_back(name);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        upperNames.push_back(name);
+    }
+
+    run("termCompare", [&](std::size_t i) {
+        std::size_t index = i % fullNames.size();
+        termGame.currentFullName = fullNames[index];
+        termGame.userInput = upperNames[index];
+        benchmarkSink += isCorrectAnswer(termGame, acronyms);
+    });
+
+    // Spaced repetition has to keep the per-question cost flat on very large decks
+    AcronymMap largeDeck;
+    largeDeck.reserve(scheduledDeckSize);
+    for (std::size_t i = 0; i < scheduledDeckSize; ++i) {
+        largeDeck.emplace("K" + std::to_string(i), "Card " + std::to_string(i));
+    }
+    QuestionScheduler scheduler(largeDeck);
+    std::mt19937 schedulerRng(1);
+
+    run("scheduler.pickAndAnswer.1M", [&](std::size_t i) {
+        std::uint32_t card = scheduler.pickNext(schedulerRng);
+        scheduler.answer(card, i % 5 != 0);
+        benchmarkSink += card;
+    });
+
+    // Both permutations have to stay O(1) per draw however large the deck is
+    ShuffledDeck fisherYatesDeck(largeDeck, 1, ShuffledDeck::Method::FisherYates);
+    run("shuffledDeck.fisherYates.1M", [&](std::size_t) {
+        benchmarkSink += fisherYatesDeck.next().first.size();
+    });
+
+    ShuffledDeck feistelDeck(largeDeck, 1, ShuffledDeck::Method::Feistel);
+    run("shuffledDeck.feistel.1M", [&](std::size_t) {
+        benchmarkSink += feistelDeck.next().first.size();
+    });
+
+    // Title-screen filters have to resolve in microseconds on large decks too
+    AcronymTags largeDeckTags;
+    for (const auto& entry : largeDeck) {
+        std::size_t number = largeDeckTags.size();
+        std::vector<std::string>& cardTags = largeDeckTags[entry.first];
+        if (number % 3 == 0) {
+            cardTags.push_back("Crypto");
+        }
+        if (number % 5 == 0) {
+            cardTags.push_back("Wireless");
+        }
+        if (number % 1000 == 0) {
+            cardTags.push_back("Rare");
+        }
+    }
+    TagIndex tagIndex(largeDeck, largeDeckTags);
+
+    run("tagFilter.dense.1M", [&](std::size_t) {
+        CardSet cards;
+        tagIndex.evaluate("Crypto AND NOT Wireless", cards);
+        benchmarkSink += cards.size();
+    });
+
+    run("tagFilter.sparse.1M", [&](std::size_t) {
+        CardSet cards;
+        tagIndex.evaluate("Rare AND NOT Wireless", cards);
+        benchmarkSink += cards.size();
+    });
+
+    // The interned deck has to answer lookups as fast as the map while using a fraction of its memory
+    InternedDeck internedDeck(largeDeck);
+    std::vector<std::string> largeDeckKeys;
+    for (std::size_t i = 0; i < 65536; ++i) {
+        largeDeckKeys.push_back("K" + std::to_string((i * 2654435761u) % scheduledDeckSize));
+    }
+    std::cout << "internedDeck.1M holds " << internedDeck.sizeInBytes() / internedDeck.size() << " bytes per card\n";
+
+    run("acronymMap.lookup.1M", [&](std::size_t i) {
+        benchmarkSink += largeDeck.count(largeDeckKeys[i % largeDeckKeys.size()]);
+    });
+
+    run("internedDeck.lookup.1M", [&](std::size_t i) {
+        benchmarkSink += internedDeck.find(largeDeckKeys[i % largeDeckKeys.size()]);
+    });
+
+    // Front coding trades some lookup time for keys that take a few bytes each
+    FrontCodedDictionary frontCodedDeck(largeDeck);
+    std::cout << "frontCodedDictionary.1M holds " << static_cast<double>(frontCodedDeck.keyBytes()) / frontCodedDeck.size()
+        << " bytes of keys per card\n";
+
+    run("frontCodedDictionary.lookup.1M", [&](std::size_t i) {
+        benchmarkSink += frontCodedDeck.find(largeDeckKeys[i % largeDeckKeys.size()]);
+    });
+
+    int insertCounter = 0;
+    run("insertScore", [&](std::size_t) {
+        insertScore("Bench " + std::to_string(insertCounter), insertCounter % 5000, LatencySummary());
+        insertCounter++;
+    });
+
+    run("getTopScores", [&](std::size_t) {
+        benchmarkSink += getTopScores().size();
+    });
+
+    std::vector<std::pair<std::string, int>> topScores = getTopScores();
+    std::vector<sf::Text> texts;
+    run("buildHighScoreTexts", [&](std::size_t) {
+        buildHighScoreTexts(font, topScores, texts);
+        benchmarkSink += texts.size();
+    });
+
+    // Measuring the font renders its glyphs, so it happens once, outside the timing
+    TextWrapStyle questionStyle = questionWrapStyle(font);
+    run("layoutText", [&](std::size_t i) {
+        benchmarkSink += layoutText(acronyms.at(keys[i % keys.size()]), questionStyle).lineCount;
+    });
+
+    run("layoutDeck", [&](std::size_t) {
+        benchmarkSink += layoutDeck(acronyms, questionStyle)->size();
+    });
+
+    // A full pool of explosion particles, topped up as they die so every update moves 100k
+    ParticleSystem particles(100000);
+    run("particles.update.100k", [&](std::size_t) {
+        while (particles.liveCount() + 1000 <= particles.capacity()) {
+            particles.spawnExplosion(sf::Vector2f(400, 300), 1000);
+        }
+        particles.update(1.0f / 60.0f);
+        benchmarkSink += particles.liveCount();
+    });
+
+    if (!writeResults(options.outputFile, results)) {
+        return 1;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << options.outputFile << "\n";
+
+    if (!baseline.empty() && compareResults(results, baseline, options.thresholdPercent) > 0) {
+        return 1;
+    }
+    return 0;
+}
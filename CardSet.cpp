@@ -0,0 +1,287 @@
+#include "CardSet.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    int popcount64(std::uint64_t word) {
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+    }
+
+    bool testBit(const std::vector<std::uint64_t>& bits, std::uint16_t offset) {
+        return (bits[offset >> 6] >> (offset & 63)) & 1;
+    }
+
+    void setBit(std::vector<std::uint64_t>& bits, std::uint16_t offset) {
+        bits[offset >> 6] |= std::uint64_t(1) << (offset & 63);
+    }
+
+    void clearBit(std::vector<std::uint64_t>& bits, std::uint16_t offset) {
+        bits[offset >> 6] &= ~(std::uint64_t(1) << (offset & 63));
+    }
+}
+
+CardSet CardSet::range(std::uint32_t count) {
+    CardSet set;
+    for (std::uint32_t start = 0; start < count; start += 0x10000) {
+        Chunk chunk;
+        chunk.key = static_cast<std::uint16_t>(start >> 16);
+        chunk.count = std::min<std::uint32_t>(count - start, 0x10000);
+        chunk.bits.assign(bitmapWords, 0);
+        for (std::uint32_t word = 0; word < chunk.count / 64; ++word) {
+            chunk.bits[word] = ~std::uint64_t(0);
+        }
+        if (chunk.count % 64 != 0) {
+            chunk.bits[chunk.count / 64] = (std::uint64_t(1) << (chunk.count % 64)) - 1;
+        }
+        normalize(chunk);
+        set.chunks.push_back(std::move(chunk));
+    }
+    return set;
+}
+
+void CardSet::add(std::uint32_t card) {
+    std::uint16_t key = static_cast<std::uint16_t>(card >> 16);
+    std::uint16_t offset = static_cast<std::uint16_t>(card);
+    if (chunks.empty() || chunks.back().key != key) {
+        chunks.emplace_back();
+        chunks.back().key = key;
+    }
+
+    Chunk& chunk = chunks.back();
+    if (chunk.bits.empty()) {
+        chunk.offsets.push_back(offset);
+    }
+    else {
+        setBit(chunk.bits, offset);
+    }
+    chunk.count++;
+    normalize(chunk);
+}
+
+bool CardSet::contains(std::uint32_t card) const {
+    std::uint16_t key = static_cast<std::uint16_t>(card >> 16);
+    auto chunk = std::lower_bound(chunks.begin(), chunks.end(), key,
+        [](const Chunk& c, std::uint16_t k) { return c.key < k; });
+    if (chunk == chunks.end() || chunk->key != key) {
+        return false;
+    }
+
+    std::uint16_t offset = static_cast<std::uint16_t>(card);
+    if (!chunk->bits.empty()) {
+        return testBit(chunk->bits, offset);
+    }
+    return std::binary_search(chunk->offsets.begin(), chunk->offsets.end(), offset);
+}
+
+std::uint32_t CardSet::size() const {
+    std::uint32_t total = 0;
+    for (const Chunk& chunk : chunks) {
+        total += chunk.count;
+    }
+    return total;
+}
+
+CardSet CardSet::intersect(const CardSet& other) const {
+    CardSet result;
+    auto a = chunks.begin();
+    auto b = other.chunks.begin();
+    while (a != chunks.end() && b != other.chunks.end()) {
+        if (a->key < b->key) {
+            ++a;
+        }
+        else if (b->key < a->key) {
+            ++b;
+        }
+        else {
+            Chunk chunk = intersectChunks(*a++, *b++);
+            if (chunk.count > 0) {
+                result.chunks.push_back(std::move(chunk));
+            }
+        }
+    }
+    return result;
+}
+
+CardSet CardSet::unite(const CardSet& other) const {
+    CardSet result;
+    auto a = chunks.begin();
+    auto b = other.chunks.begin();
+    while (a != chunks.end() || b != other.chunks.end()) {
+        if (b == other.chunks.end() || (a != chunks.end() && a->key < b->key)) {
+            result.chunks.push_back(*a++);
+        }
+        else if (a == chunks.end() || b->key < a->key) {
+            result.chunks.push_back(*b++);
+        }
+        else {
+            result.chunks.push_back(uniteChunks(*a++, *b++));
+        }
+    }
+    return result;
+}
+
+CardSet CardSet::subtract(const CardSet& other) const {
+    CardSet result;
+    auto b = other.chunks.begin();
+    for (const Chunk& chunk : chunks) {
+        while (b != other.chunks.end() && b->key < chunk.key) {
+            ++b;
+        }
+        if (b == other.chunks.end() || b->key != chunk.key) {
+            result.chunks.push_back(chunk);
+            continue;
+        }
+        Chunk difference = subtractChunks(chunk, *b);
+        if (difference.count > 0) {
+            result.chunks.push_back(std::move(difference));
+        }
+    }
+    return result;
+}
+
+std::vector<std::uint32_t> CardSet::cards() const {
+    std::vector<std::uint32_t> result;
+    result.reserve(size());
+    for (const Chunk& chunk : chunks) {
+        std::uint32_t base = static_cast<std::uint32_t>(chunk.key) << 16;
+        if (chunk.bits.empty()) {
+            for (std::uint16_t offset : chunk.offsets) {
+                result.push_back(base | offset);
+            }
+            continue;
+        }
+        for (std::size_t word = 0; word < bitmapWords; ++word) {
+            for (std::uint64_t bits = chunk.bits[word]; bits != 0; bits &= bits - 1) {
+                // The lowest set bit is the only one that differs between bits and bits - 1
+                int bit = popcount64((bits ^ (bits - 1)) >> 1);
+                result.push_back(base | static_cast<std::uint32_t>(word * 64 + bit));
+            }
+        }
+    }
+    return result;
+}
+
+std::size_t CardSet::sizeInBytes() const {
+    std::size_t bytes = chunks.capacity() * sizeof(Chunk);
+    for (const Chunk& chunk : chunks) {
+        bytes += chunk.offsets.capacity() * sizeof(std::uint16_t) + chunk.bits.capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+void CardSet::normalize(Chunk& chunk) {
+    if (chunk.bits.empty() && chunk.count > arrayLimit) {
+        chunk.bits.assign(bitmapWords, 0);
+        for (std::uint16_t offset : chunk.offsets) {
+            setBit(chunk.bits, offset);
+        }
+        std::vector<std::uint16_t>().swap(chunk.offsets);
+    }
+    else if (!chunk.bits.empty() && chunk.count <= arrayLimit) {
+        chunk.offsets.clear();
+        chunk.offsets.reserve(chunk.count);
+        for (std::uint32_t offset = 0; offset < 0x10000; ++offset) {
+            if (testBit(chunk.bits, static_cast<std::uint16_t>(offset))) {
+                chunk.offsets.push_back(static_cast<std::uint16_t>(offset));
+            }
+        }
+        std::vector<std::uint64_t>().swap(chunk.bits);
+    }
+}
+
+CardSet::Chunk CardSet::intersectChunks(const Chunk& a, const Chunk& b) {
+    Chunk result;
+    result.key = a.key;
+    if (!a.bits.empty() && !b.bits.empty()) {
+        result.bits.resize(bitmapWords);
+        for (std::size_t word = 0; word < bitmapWords; ++word) {
+            result.bits[word] = a.bits[word] & b.bits[word];
+            result.count += popcount64(result.bits[word]);
+        }
+    }
+    else if (a.bits.empty() && b.bits.empty()) {
+        std::set_intersection(a.offsets.begin(), a.offsets.end(), b.offsets.begin(), b.offsets.end(),
+            std::back_inserter(result.offsets));
+        result.count = static_cast<std::uint32_t>(result.offsets.size());
+    }
+    else {
+        // Keep the array entries that are set in the bitmap
+        const Chunk& array = a.bits.empty() ? a : b;
+        const Chunk& bitmap = a.bits.empty() ? b : a;
+        for (std::uint16_t offset : array.offsets) {
+            if (testBit(bitmap.bits, offset)) {
+                result.offsets.push_back(offset);
+            }
+        }
+        result.count = static_cast<std::uint32_t>(result.offsets.size());
+    }
+    normalize(result);
+    return result;
+}
+
+CardSet::Chunk CardSet::uniteChunks(const Chunk& a, const Chunk& b) {
+    Chunk result;
+    result.key = a.key;
+    if (a.bits.empty() && b.bits.empty()) {
+        std::set_union(a.offsets.begin(), a.offsets.end(), b.offsets.begin(), b.offsets.end(),
+            std::back_inserter(result.offsets));
+        result.count = static_cast<std::uint32_t>(result.offsets.size());
+    }
+    else {
+        result.bits = a.bits.empty() ? b.bits : a.bits;
+        if (a.bits.empty() || b.bits.empty()) {
+            for (std::uint16_t offset : (a.bits.empty() ? a : b).offsets) {
+                setBit(result.bits, offset);
+            }
+        }
+        else {
+            for (std::size_t word = 0; word < bitmapWords; ++word) {
+                result.bits[word] |= b.bits[word];
+            }
+        }
+        for (std::uint64_t word : result.bits) {
+            result.count += popcount64(word);
+        }
+    }
+    normalize(result);
+    return result;
+}
+
+CardSet::Chunk CardSet::subtractChunks(const Chunk& a, const Chunk& b) {
+    Chunk result;
+    result.key = a.key;
+    if (a.bits.empty() && b.bits.empty()) {
+        std::set_difference(a.offsets.begin(), a.offsets.end(), b.offsets.begin(), b.offsets.end(),
+            std::back_inserter(result.offsets));
+        result.count = static_cast<std::uint32_t>(result.offsets.size());
+    }
+    else if (a.bits.empty()) {
+        for (std::uint16_t offset : a.offsets) {
+            if (!testBit(b.bits, offset)) {
+                result.offsets.push_back(offset);
+            }
+        }
+        result.count = static_cast<std::uint32_t>(result.offsets.size());
+    }
+    else {
+        result.bits = a.bits;
+        if (b.bits.empty()) {
+            for (std::uint16_t offset : b.offsets) {
+                clearBit(result.bits, offset);
+            }
+        }
+        else {
+            for (std::size_t word = 0; word < bitmapWords; ++word) {
+                result.bits[word] &= ~b.bits[word];
+            }
+        }
+        for (std::uint64_t word : result.bits) {
+            result.count += popcount64(word);
+        }
+    }
+    normalize(result);
+    return result;
+}
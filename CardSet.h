@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A set of card indices stored like a Roaring bitmap.
+//
+// An index is split into a chunk number (high 16 bits) and an offset within the chunk (low 16
+// bits). Every non-empty chunk keeps its offsets as a sorted array while it holds up to 4096 of
+// them, and as a 65536-bit bitmap (8 KB) once that is smaller. A sparse tag costs two bytes per
+// card and a dense one an eighth of a byte, and set operations work a chunk at a time on whole
+// arrays or 64-bit words instead of card by card.
+class CardSet {
+public:
+    // Function to build the set {0, 1, ..., count - 1}
+    static CardSet range(std::uint32_t count);
+
+    // Function to add a card; cards have to be added in increasing order
+    void add(std::uint32_t card);
+
+    bool contains(std::uint32_t card) const;
+    std::uint32_t size() const;
+    bool empty() const { return chunks.empty(); }
+
+    CardSet intersect(const CardSet& other) const; // this AND other
+    CardSet unite(const CardSet& other) const;     // this OR other
+    CardSet subtract(const CardSet& other) const;  // this AND NOT other
+
+    // Function to list the cards in increasing order
+    std::vector<std::uint32_t> cards() const;
+
+    // Function to report the memory held by the chunks
+    std::size_t sizeInBytes() const;
+
+private:
+    struct Chunk {
+        std::uint16_t key = 0;              // High 16 bits shared by the chunk's cards
+        std::uint32_t count = 0;
+        std::vector<std::uint16_t> offsets; // Sorted low 16 bits, while count <= arrayLimit
+        std::vector<std::uint64_t> bits;    // 1024 words, once count > arrayLimit
+    };
+
+    static const std::uint32_t arrayLimit = 4096;
+    static const std::size_t bitmapWords = 1024;
+
+    static void normalize(Chunk& chunk);
+    static Chunk intersectChunks(const Chunk& a, const Chunk& b);
+    static Chunk uniteChunks(const Chunk& a, const Chunk& b);
+    static Chunk subtractChunks(const Chunk& a, const Chunk& b);
+
+    std::vector<Chunk> chunks; // Sorted by key, none of them empty
+};
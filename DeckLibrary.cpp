@@ -0,0 +1,225 @@
+#include "DeckLibrary.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    // One deck file as parsed by its worker
+    struct ParsedDeck {
+        AcronymMap acronyms;
+        AcronymWeights weights;
+        AcronymTags tags;
+    };
+
+    double millisSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void parseDeck(const std::string& file, ParsedDeck& parsed, DeckSource& source) {
+        auto start = std::chrono::steady_clock::now();
+        parsed.acronyms = loadAcronyms(file, parsed.weights, parsed.tags);
+        source.parsed = parsed.acronyms.size();
+        source.parseMillis = millisSince(start);
+    }
+
+    void sortDeckCards(std::vector<const std::string*>& cards) {
+        std::sort(cards.begin(), cards.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    }
+
+    // Function to merge parsed decks into the library, later decks winning. The decks are merged
+    // from the last one backwards and every acronym is kept from the first deck that inserts it.
+    // Map nodes are moved, not copied, so no acronym or full name is allocated twice.
+    void mergeDecks(std::vector<ParsedDeck>& parsed, DeckLibrary& library) {
+        library.deckCards.assign(parsed.size(), std::vector<const std::string*>());
+
+        // A single deck is taken over as it is, so it iterates exactly like loadAcronyms() would
+        if (parsed.size() == 1) {
+            library.acronyms = std::move(parsed[0].acronyms);
+            library.weights = std::move(parsed[0].weights);
+            library.tags = std::move(parsed[0].tags);
+            library.deckCards[0].reserve(library.acronyms.size());
+            for (const auto& entry : library.acronyms) {
+                library.deckCards[0].push_back(&entry.first);
+            }
+            library.decks[0].used = library.acronyms.size();
+            return;
+        }
+
+        std::size_t total = 0;
+        for (const ParsedDeck& deck : parsed) {
+            total += deck.acronyms.size();
+        }
+        library.acronyms.reserve(total);
+        library.tags.reserve(total);
+
+        for (std::size_t index = parsed.size(); index-- > 0;) {
+            ParsedDeck& deck = parsed[index];
+            std::vector<const std::string*>& cards = library.deckCards[index];
+            cards.reserve(deck.acronyms.size());
+            for (auto it = deck.acronyms.begin(); it != deck.acronyms.end();) {
+                auto result = library.acronyms.insert(deck.acronyms.extract(it++));
+                if (!result.inserted) {
+                    continue; // A later deck defines it
+                }
+
+                const std::string& acronym = result.position->first;
+                cards.push_back(&acronym);
+                auto weight = deck.weights.find(acronym);
+                if (weight != deck.weights.end()) {
+                    library.weights.insert(deck.weights.extract(weight));
+                }
+                auto tags = deck.tags.find(acronym);
+                if (tags != deck.tags.end()) {
+                    library.tags.insert(deck.tags.extract(tags));
+                }
+            }
+            library.decks[index].used = cards.size();
+        }
+    }
+}
+
+int DeckLibrary::deckOf(const std::string& acronym) const {
+    for (std::size_t index = 0; index < deckCards.size(); ++index) {
+        const std::vector<const std::string*>& cards = deckCards[index];
+        auto it = std::lower_bound(cards.begin(), cards.end(), acronym,
+            [](const std::string* card, const std::string& key) { return *card < key; });
+        if (it != cards.end() && **it == acronym) {
+            return static_cast<int>(index);
+        }
+    }
+    return -1;
+}
+
+bool loadDeckFile(const std::string& filename, DeckLibrary& library) {
+    library = DeckLibrary();
+    library.decks.resize(1);
+    library.decks[0].file = filename;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ParsedDeck> parsed(1);
+    parseDeck(filename, parsed[0], library.decks[0]);
+    library.loadMillis = millisSince(start);
+
+    start = std::chrono::steady_clock::now();
+    mergeDecks(parsed, library);
+    sortDeckCards(library.deckCards[0]);
+    library.mergeMillis = millisSince(start);
+    return !library.acronyms.empty();
+}
+
+bool loadDeckText(const std::string& name, std::string_view text, DeckLibrary& library) {
+    auto start = std::chrono::steady_clock::now();
+    AcronymWeights weights;
+    AcronymTags tags;
+    AcronymMap acronyms = parseAcronyms(text, weights, tags);
+    double parseMillis = millisSince(start);
+
+    bool loaded = adoptDeck(name, std::move(acronyms), std::move(weights), std::move(tags), library);
+    library.decks[0].parseMillis = parseMillis;
+    library.loadMillis = parseMillis;
+    return loaded;
+}
+
+bool adoptDeck(const std::string& name, AcronymMap acronyms, AcronymWeights weights, AcronymTags tags, DeckLibrary& library) {
+    library = DeckLibrary();
+    library.decks.resize(1);
+    library.decks[0].file = name;
+    library.decks[0].parsed = acronyms.size();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ParsedDeck> parsed(1);
+    parsed[0].acronyms = std::move(acronyms);
+    parsed[0].weights = std::move(weights);
+    parsed[0].tags = std::move(tags);
+    mergeDecks(parsed, library);
+    sortDeckCards(library.deckCards[0]);
+    library.mergeMillis = millisSince(start);
+    return !library.acronyms.empty();
+}
+
+bool loadDeckDirectory(const std::string& directory, DeckLibrary& library, unsigned threadCount) {
+    std::vector<std::filesystem::path> files;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->is_regular_file() && it->path().extension() == ".txt") {
+            files.push_back(it->path());
+        }
+    }
+    if (error) {
+        std::cerr << "Error: Unable to read deck directory: " << directory << std::endl;
+        return false;
+    }
+    if (files.empty()) {
+        std::cerr << "Error: No .txt decks in " << directory << std::endl;
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+
+    library = DeckLibrary();
+    library.decks.resize(files.size());
+    for (std::size_t index = 0; index < files.size(); ++index) {
+        library.decks[index].file = files[index].string();
+    }
+
+    // Workers run their newest task first and steal the oldest, so submitting the smallest files
+    // first makes every worker start on a big file and leaves the small ones for stealing at the end
+    std::vector<std::size_t> order(files.size());
+    std::vector<std::uintmax_t> sizes(files.size());
+    for (std::size_t index = 0; index < files.size(); ++index) {
+        order[index] = index;
+        sizes[index] = std::filesystem::file_size(files[index], error);
+    }
+    std::sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) { return sizes[a] < sizes[b]; });
+
+    std::vector<ParsedDeck> parsed(files.size());
+    WorkStealingPool pool(std::min<unsigned>(std::max(threadCount, 1u), static_cast<unsigned>(files.size())));
+    library.threads = pool.size();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t index : order) {
+        pool.submit([index, &parsed, &library]() {
+            parseDeck(library.decks[index].file, parsed[index], library.decks[index]);
+        });
+    }
+    pool.wait();
+    library.loadMillis = millisSince(start);
+
+    // Merging into one map is serial; sorting each deck's provenance list is not
+    start = std::chrono::steady_clock::now();
+    mergeDecks(parsed, library);
+    for (std::vector<const std::string*>& cards : library.deckCards) {
+        pool.submit([&cards]() { sortDeckCards(cards); });
+    }
+    pool.wait();
+    library.mergeMillis = millisSince(start);
+    return true;
+}
+
+bool loadDeckLibrary(const std::string& path, DeckLibrary& library) {
+    std::error_code error;
+    if (std::filesystem::is_directory(path, error)) {
+        return loadDeckDirectory(path, library);
+    }
+    return loadDeckFile(path, library);
+}
+
+void printDeckLoadTimes(const DeckLibrary& library, std::ostream& out) {
+    double parseTotal = 0.0;
+    for (const DeckSource& deck : library.decks) {
+        parseTotal += deck.parseMillis;
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    out << "Loaded " << library.acronyms.size() << " acronyms from " << library.decks.size() << " decks on "
+        << library.threads << " threads: parse " << library.loadMillis << "ms (" << parseTotal << "ms of work, "
+        << (library.loadMillis > 0.0 ? parseTotal / library.loadMillis : 1.0) << "x), merge " << library.mergeMillis << "ms\n";
+    for (const DeckSource& deck : library.decks) {
+        out << "  " << deck.file << ": " << deck.parsed << " acronyms, " << deck.used << " used, "
+            << deck.parseMillis << "ms\n";
+    }
+    out.flags(flags);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Acronyms.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// One deck file of a library
+struct DeckSource {
+    std::string file;
+    std::size_t parsed = 0;    // Acronyms in the file
+    std::size_t used = 0;      // Acronyms the library took from this file (later files win duplicates)
+    double parseMillis = 0.0;  // Time to read and parse the file on its worker
+};
+
+// The acronyms of one or more deck files merged into one deck, remembering which file each came from.
+// Acronyms that appear in several files are taken from the last one in file name order, the same way
+// a later line of one file replaces an earlier one.
+struct DeckLibrary {
+    AcronymMap acronyms;
+    AcronymWeights weights;
+    AcronymTags tags;
+    std::vector<DeckSource> decks;  // In file name order
+
+    double loadMillis = 0.0;        // Wall time to parse every file
+    double mergeMillis = 0.0;       // Wall time to merge them and index the provenance
+    unsigned threads = 1;
+
+    DeckLibrary() = default;
+    DeckLibrary(DeckLibrary&&) = default;
+    DeckLibrary& operator=(DeckLibrary&&) = default;
+    DeckLibrary(const DeckLibrary&) = delete; // deckCards points into acronyms
+    DeckLibrary& operator=(const DeckLibrary&) = delete;
+
+    // Function to find the deck an acronym was taken from, -1 if it is not in the library
+    int deckOf(const std::string& acronym) const;
+
+    // The acronyms each deck contributed, sorted, pointing at the keys of acronyms
+    std::vector<std::vector<const std::string*>> deckCards;
+};
+
+// Function to load a single deck file as a library of one
+bool loadDeckFile(const std::string& filename, DeckLibrary& library);
+
+// Function to load a deck that is already in memory, e.g. read from an asset archive, as a library of one
+bool loadDeckText(const std::string& name, std::string_view text, DeckLibrary& library);
+
+// Function to take over a deck that was built some other way, e.g. compiled into the executable, as a library of one
+bool adoptDeck(const std::string& name, AcronymMap acronyms, AcronymWeights weights, AcronymTags tags, DeckLibrary& library);
+
+// Function to load every .txt deck in a directory, parsing the files in parallel on a
+// WorkStealingPool, and merge them. Returns false if the directory has no decks.
+bool loadDeckDirectory(const std::string& directory, DeckLibrary& library,
+    unsigned threadCount = std::thread::hardware_concurrency());
+
+// Function to load a deck directory or a single deck file, whichever path names
+bool loadDeckLibrary(const std::string& path, DeckLibrary& library);
+
+// Function to print how long each file took to parse and how long the merge took
+void printDeckLoadTimes(const DeckLibrary& library, std::ostream& out);
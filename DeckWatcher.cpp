@@ -0,0 +1,335 @@
+#include "DeckWatcher.h"
+#include "EmbeddedAssets.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // How long a wait for a change lasts before the stop flag is checked again
+    const int waitMillis = 250;
+
+    // How long the file has to stay unchanged before it is read; editors often save in several writes
+    const int settleMillis = 100;
+
+    // Modification time and size, to tell whether the deck itself changed since it was loaded. For a
+    // directory the newest time and the total size of its decks are used.
+    struct FileStamp {
+        std::filesystem::file_time_type time;
+        std::uintmax_t size = 0;
+        bool exists = false;
+
+        bool operator==(const FileStamp& other) const {
+            return exists == other.exists && time == other.time && size == other.size;
+        }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    FileStamp readStamp(const std::filesystem::path& path) {
+        FileStamp stamp;
+        std::error_code error;
+        stamp.time = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return stamp;
+        }
+        if (!std::filesystem::is_directory(path, error)) {
+            stamp.size = std::filesystem::file_size(path, error);
+            stamp.exists = !error;
+            return stamp;
+        }
+
+        // Removing a deck changes the directory's own time, editing one only the deck's
+        for (std::filesystem::directory_iterator it(path, error), end; !error && it != end; it.increment(error)) {
+            if (it->path().extension() == ".txt") {
+                stamp.time = std::max(stamp.time, std::filesystem::last_write_time(it->path(), error));
+                stamp.size += std::filesystem::file_size(it->path(), error);
+            }
+        }
+        stamp.exists = true;
+        return stamp;
+    }
+
+    std::filesystem::path watchedDirectory(const std::filesystem::path& file) {
+        std::error_code error;
+        if (std::filesystem::is_directory(file, error)) {
+            return file;
+        }
+        std::filesystem::path directory = file.parent_path();
+        return directory.empty() ? std::filesystem::path(".") : directory;
+    }
+
+    // Blocks until something may have changed in the deck's directory. Editors usually save by
+    // writing a temporary file and renaming it over the old one, so the directory is watched rather
+    // than the file; the caller compares file stamps to ignore changes to other files.
+#if defined(_WIN32)
+    class FileChangeWaiter {
+    public:
+        explicit FileChangeWaiter(const std::filesystem::path& file) {
+            handle = FindFirstChangeNotificationW(watchedDirectory(file).c_str(), FALSE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE);
+            if (handle == INVALID_HANDLE_VALUE) {
+                std::cerr << "Warning: Unable to watch " << file.string() << " for changes, polling instead\n";
+            }
+        }
+
+        ~FileChangeWaiter() {
+            if (handle != INVALID_HANDLE_VALUE) {
+                FindCloseChangeNotification(handle);
+            }
+        }
+
+        bool wait(int timeoutMillis) {
+            if (handle == INVALID_HANDLE_VALUE) {
+                Sleep(static_cast<DWORD>(timeoutMillis));
+                return true;
+            }
+            if (WaitForSingleObject(handle, static_cast<DWORD>(timeoutMillis)) != WAIT_OBJECT_0) {
+                return false;
+            }
+            FindNextChangeNotification(handle);
+            return true;
+        }
+
+    private:
+        HANDLE handle = INVALID_HANDLE_VALUE;
+    };
+#elif defined(__linux__)
+    class FileChangeWaiter {
+    public:
+        explicit FileChangeWaiter(const std::filesystem::path& file) {
+            descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (descriptor >= 0 && inotify_add_watch(descriptor, watchedDirectory(file).c_str(),
+                IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0) {
+                close(descriptor);
+                descriptor = -1;
+            }
+            if (descriptor < 0) {
+                std::cerr << "Warning: Unable to watch " << file.string() << " for changes, polling instead\n";
+            }
+        }
+
+        ~FileChangeWaiter() {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+
+        bool wait(int timeoutMillis) {
+            if (descriptor < 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMillis));
+                return true;
+            }
+            pollfd request = { descriptor, POLLIN, 0 };
+            if (poll(&request, 1, timeoutMillis) <= 0) {
+                return false;
+            }
+            char events[4096];
+            while (read(descriptor, events, sizeof(events)) > 0) {
+                // Drain the queue; which file changed is decided by the file stamp
+            }
+            return true;
+        }
+
+    private:
+        int descriptor = -1;
+    };
+#else
+    class FileChangeWaiter {
+    public:
+        explicit FileChangeWaiter(const std::filesystem::path&) {
+        }
+
+        bool wait(int timeoutMillis) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMillis));
+            return true;
+        }
+    };
+#endif
+
+    // Function to look up a weight, absent weights are told apart from an explicit 1
+    const float* findWeight(const AcronymWeights& weights, const std::string& acronym) {
+        auto it = weights.find(acronym);
+        return it != weights.end() ? &it->second : nullptr;
+    }
+
+    const std::vector<std::string>* findTags(const AcronymTags& tags, const std::string& acronym) {
+        auto it = tags.find(acronym);
+        return it != tags.end() ? &it->second : nullptr;
+    }
+
+    // Function to check that two decks with the same entries also iterate in the same order. Question
+    // selection and replays depend on the order, so it has to match what a fresh start would load.
+    bool sameIterationOrder(const AcronymMap& a, const AcronymMap& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+            [](const AcronymMap::value_type& x, const AcronymMap::value_type& y) { return x.first == y.first; });
+    }
+}
+
+std::shared_ptr<DeckSnapshot> loadDeckSnapshot(const std::string& path) {
+    auto deck = std::make_shared<DeckSnapshot>();
+    if (!loadDeckLibrary(path, deck->library) || deck->library.acronyms.empty()) {
+        return nullptr;
+    }
+    deck->tagIndex = std::make_unique<TagIndex>(deck->library.acronyms, deck->library.tags);
+    return deck;
+}
+
+std::shared_ptr<DeckSnapshot> loadDeckSnapshot(const std::string& name, std::string_view text) {
+    auto deck = std::make_shared<DeckSnapshot>();
+    if (!loadDeckText(name, text, deck->library)) {
+        return nullptr;
+    }
+    deck->tagIndex = std::make_unique<TagIndex>(deck->library.acronyms, deck->library.tags);
+    return deck;
+}
+
+std::shared_ptr<DeckSnapshot> loadEmbeddedDeckSnapshot(const std::string& name) {
+    auto deck = std::make_shared<DeckSnapshot>();
+    if (!loadEmbeddedDeck(name, deck->library)) {
+        return nullptr;
+    }
+    deck->tagIndex = std::make_unique<TagIndex>(deck->library.acronyms, deck->library.tags);
+    return deck;
+}
+
+DeckChanges diffDecks(const DeckSnapshot& beforeSnapshot, const DeckSnapshot& afterSnapshot) {
+    const DeckLibrary& before = beforeSnapshot.library;
+    const DeckLibrary& after = afterSnapshot.library;
+    DeckChanges changes;
+    for (const auto& entry : before.acronyms) {
+        auto match = after.acronyms.find(entry.first);
+        if (match == after.acronyms.end()) {
+            changes.deleted.push_back(entry.first);
+            continue;
+        }
+
+        const float* oldWeight = findWeight(before.weights, entry.first);
+        const float* newWeight = findWeight(after.weights, entry.first);
+        const std::vector<std::string>* oldTags = findTags(before.tags, entry.first);
+        const std::vector<std::string>* newTags = findTags(after.tags, entry.first);
+        bool weightChanged = (oldWeight == nullptr) != (newWeight == nullptr) || (oldWeight && *oldWeight != *newWeight);
+        bool tagsChanged = (oldTags == nullptr) != (newTags == nullptr) || (oldTags && *oldTags != *newTags);
+        if (match->second != entry.second || weightChanged || tagsChanged) {
+            changes.changed.push_back(entry.first);
+        }
+    }
+    for (const auto& entry : after.acronyms) {
+        if (before.acronyms.find(entry.first) == before.acronyms.end()) {
+            changes.inserted.push_back(entry.first);
+        }
+    }
+
+    std::sort(changes.inserted.begin(), changes.inserted.end());
+    std::sort(changes.deleted.begin(), changes.deleted.end());
+    std::sort(changes.changed.begin(), changes.changed.end());
+    return changes;
+}
+
+DeckWatcher::DeckWatcher(const std::string& deckPath)
+    : path(deckPath), latestGeneration(0), stopping(false) {
+    watcherThread = std::thread(&DeckWatcher::run, this);
+}
+
+DeckWatcher::~DeckWatcher() {
+    stopping = true;
+    watcherThread.join();
+}
+
+std::shared_ptr<const DeckSnapshot> DeckWatcher::current() {
+    std::unique_lock<std::mutex> lock(snapshotMutex);
+    firstLoad.wait(lock, [this]() { return loaded; });
+    return snapshot;
+}
+
+void DeckWatcher::run() {
+    // Start watching before the first load so an edit made during it is not missed
+    FileChangeWaiter waiter(path);
+    FileStamp loadedStamp = readStamp(path);
+    reload();
+
+    while (!stopping) {
+        if (!waiter.wait(waitMillis)) {
+            continue;
+        }
+        FileStamp stamp = readStamp(path);
+        if (stamp == loadedStamp) {
+            continue; // Another file in the directory changed
+        }
+
+        do {
+            loadedStamp = stamp;
+            std::this_thread::sleep_for(std::chrono::milliseconds(settleMillis));
+            stamp = readStamp(path);
+        } while (stamp != loadedStamp && !stopping);
+        reload();
+    }
+}
+
+void DeckWatcher::reload() {
+    auto started = std::chrono::steady_clock::now();
+    auto next = std::make_shared<DeckSnapshot>();
+    bool loadedDeck = loadDeckLibrary(path, next->library) && !next->library.acronyms.empty();
+
+    std::shared_ptr<const DeckSnapshot> previous;
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        previous = snapshot;
+    }
+
+    if (!loadedDeck && previous) {
+        std::cerr << "Warning: " << path << " has no acronyms, keeping the previous version\n";
+        return;
+    }
+    if (!loadedDeck) {
+        // Nothing to fall back to; play with an empty deck like loadAcronyms does
+        next->library = DeckLibrary();
+    }
+
+    if (previous) {
+        DeckChanges changes = diffDecks(*previous, *next);
+        bool sameCards = sameIterationOrder(previous->library.acronyms, next->library.acronyms);
+        if (changes.empty() && sameCards) {
+            return;
+        }
+
+        // Edits that keep every card's number only touch the tag sets of the edited cards; inserts
+        // and deletes renumber the cards, so the index is built again
+        if (sameCards) {
+            next->tagIndex = std::make_unique<TagIndex>(*previous->tagIndex, previous->library.tags,
+                next->library.acronyms, next->library.tags, changes.changed);
+        }
+        else {
+            next->tagIndex = std::make_unique<TagIndex>(next->library.acronyms, next->library.tags);
+        }
+        next->generation = previous->generation + 1;
+        std::cout << "Reloaded " << path << ": " << changes.inserted.size() << " added, " << changes.deleted.size()
+            << " removed, " << changes.changed.size() << " changed" << (sameCards ? ", tag index patched" : "") << " ("
+            << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count() << "ms)\n";
+    }
+    else {
+        next->tagIndex = std::make_unique<TagIndex>(next->library.acronyms, next->library.tags);
+        next->generation = 1;
+    }
+    if (next->library.decks.size() > 1) {
+        printDeckLoadTimes(next->library, std::cout);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        snapshot = std::move(next);
+        loaded = true;
+        latestGeneration = snapshot->generation;
+    }
+    firstLoad.notify_all();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "Acronyms.h"
+#include "DeckLibrary.h"
+#include "TagIndex.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// One version of the deck file or directory, loaded and indexed. Snapshots are never modified once
+// published, so a round can keep using its snapshot while a newer one is built.
+struct DeckSnapshot {
+    DeckLibrary library;
+    std::unique_ptr<TagIndex> tagIndex; // Points into library.acronyms
+    std::uint64_t generation = 0;       // Increases by one with every reload that changed something
+};
+
+// What changed between two versions of the deck, by acronym
+struct DeckChanges {
+    std::vector<std::string> inserted;
+    std::vector<std::string> deleted;
+    std::vector<std::string> changed; // Full name, weight or tags differ
+
+    bool empty() const { return inserted.empty() && deleted.empty() && changed.empty(); }
+};
+
+// Function to load and index a deck file or directory, returns nullptr if it is missing or has no acronyms
+std::shared_ptr<DeckSnapshot> loadDeckSnapshot(const std::string& path);
+
+// Function to load and index a deck that is already in memory, returns nullptr if it has no acronyms
+std::shared_ptr<DeckSnapshot> loadDeckSnapshot(const std::string& name, std::string_view text);
+
+// Function to index the deck compiled into the executable, returns nullptr if name is not the embedded deck
+std::shared_ptr<DeckSnapshot> loadEmbeddedDeckSnapshot(const std::string& name);
+
+// Function to compare two versions of a deck
+DeckChanges diffDecks(const DeckSnapshot& before, const DeckSnapshot& after);
+
+// Keeps the newest version of a deck file or directory while the game runs, so decks can be edited live.
+//
+// A background thread waits for the file to change (FindFirstChangeNotification on Windows,
+// inotify on Linux, polling the modification time elsewhere), parses the new version, diffs it
+// against the current one and, if anything changed, indexes it and swaps it in under a lock that is
+// only held for the pointer copy. The render and simulation threads never touch the watcher; rounds
+// pick up the newest snapshot when they start, so a round and its replay always use one version.
+//
+// The deck itself is always parsed into a fresh map, whose iteration order has to match what a
+// fresh start would load. The tag index is applied incrementally when the edit only changed
+// existing cards: the sets of the tags those cards had or have now are patched and every other set
+// is shared with the previous version. An added or removed card renumbers the cards, so the index
+// is then built again.
+//
+// A save that leaves the file empty or unreadable (e.g. half-written) keeps the previous version.
+class DeckWatcher {
+public:
+    // Function to start watching; the first version is loaded on the watcher thread
+    explicit DeckWatcher(const std::string& deckPath);
+    ~DeckWatcher();
+
+    DeckWatcher(const DeckWatcher&) = delete;
+    DeckWatcher& operator=(const DeckWatcher&) = delete;
+
+    // Function to return the newest version, waiting for the first load; nullptr if it failed
+    std::shared_ptr<const DeckSnapshot> current();
+
+    // Function to read the generation of the newest version without waiting
+    std::uint64_t generation() const { return latestGeneration; }
+
+private:
+    void run();
+    void reload();
+
+    std::string path;
+    std::mutex snapshotMutex;
+    std::condition_variable firstLoad;
+    bool loaded = false;
+    std::shared_ptr<const DeckSnapshot> snapshot;
+    std::atomic<std::uint64_t> latestGeneration;
+    std::atomic<bool> stopping;
+    std::thread watcherThread;
+};
@@ -0,0 +1,44 @@
+#include "EmbeddedAssets.h"
+
+#if !defined(EMBED_ASSETS)
+// Nothing embedded; EmbeddedAssets.generated.cpp defines the tables otherwise
+const EmbeddedAssets embeddedAssets = { nullptr, 0, std::string_view(), nullptr, 0, nullptr };
+#endif
+
+bool findEmbeddedFile(const std::string& name, const void*& data, std::size_t& size) {
+    // A handful of files, so a linear search is as fast as anything else
+    for (std::size_t i = 0; i < embeddedAssets.fileCount; ++i) {
+        const EmbeddedFile& file = embeddedAssets.files[i];
+        if (file.name == name) {
+            data = file.data;
+            size = file.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool loadEmbeddedDeck(const std::string& name, DeckLibrary& library) {
+    if (embeddedAssets.cardCount == 0 || embeddedAssets.deckName != name) {
+        return false;
+    }
+
+    // No reserve(): loadAcronyms() grows the map one insert at a time, and the bucket count
+    // decides the iteration order, which card numbers and replays depend on
+    AcronymMap acronyms;
+    AcronymWeights weights;
+    AcronymTags tags;
+    for (std::size_t i = 0; i < embeddedAssets.cardCount; ++i) {
+        const EmbeddedCard& card = embeddedAssets.cards[i];
+        std::string acronym(card.acronym);
+        if (card.weighted) {
+            weights.emplace(acronym, card.weight);
+        }
+        if (card.tagged) {
+            const std::string_view* first = embeddedAssets.tags + card.firstTag;
+            tags.emplace(acronym, std::vector<std::string>(first, first + card.tagCount));
+        }
+        acronyms.emplace(std::move(acronym), std::string(card.fullName));
+    }
+    return adoptDeck(name, std::move(acronyms), std::move(weights), std::move(tags), library);
+}
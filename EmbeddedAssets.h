@@ -0,0 +1,57 @@
+#pragma once
+#include "DeckLibrary.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Assets compiled into the executable, so a kiosk build runs without any files next to it.
+//
+// With EMBED_ASSETS defined (Release builds), a pre-build step runs "Asset Packer --embed", which
+// writes EmbeddedAssets.generated.cpp: the default fonts and textures as constexpr byte arrays and
+// the default deck already split into its fields, in the order its acronyms first appear in the
+// file. Without it the tables are empty and everything comes from the archive or loose files.
+//
+// The embedded deck skips reading and splitting text, but it is not a ready-made index. At start
+// loadEmbeddedDeck() still copies every field into a heap std::string and builds the AcronymMap,
+// the weights and the tags, and the caller builds the TagIndex, because the scheduler, the tag
+// index and the rest of the round read the deck through those maps. A static, arena-backed index
+// would only pay off once the round reads card numbers and string views instead (see InternedDeck.h).
+
+// One embedded file, under the path the game asks for ("Fonts/arial.ttf")
+struct EmbeddedFile {
+    std::string_view name;
+    const unsigned char* data;
+    std::size_t size;
+};
+
+// One card of the embedded deck; its tags are tagCount entries of EmbeddedAssets::tags from firstTag
+struct EmbeddedCard {
+    std::string_view acronym;
+    std::string_view fullName;
+    float weight;
+    bool weighted;
+    bool tagged;
+    std::uint32_t firstTag;
+    std::uint32_t tagCount;
+};
+
+struct EmbeddedAssets {
+    const EmbeddedFile* files;
+    std::size_t fileCount;
+    std::string_view deckName; // The deck file the cards were generated from, e.g. "acronyms.txt"
+    const EmbeddedCard* cards;
+    std::size_t cardCount;
+    const std::string_view* tags;
+};
+
+extern const EmbeddedAssets embeddedAssets;
+
+// Function to find an embedded file, returns false if it is not embedded
+bool findEmbeddedFile(const std::string& name, const void*& data, std::size_t& size);
+
+// Function to build a library of one from the embedded deck, without parsing any text (but with a
+// copy of every field, see above). Cards are inserted in the order loadAcronyms() would insert
+// them, so the deck iterates the same way.
+// Returns false if no deck is embedded or name is not the deck that was embedded.
+bool loadEmbeddedDeck(const std::string& name, DeckLibrary& library);
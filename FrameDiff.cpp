@@ -0,0 +1,191 @@
+// Frame diff.
+// Compares the frames the game captures with --capture (title, gameplay, leaderboard) against stored
+// goldens, so a rendering change such as batching or a texture atlas can be checked for looking the
+// same. Every PNG in the golden directory needs a frame of the same name and size in the capture
+// directory. For each frame it reports how many pixels differ by more than the tolerance in any
+// channel, the largest difference, the mean absolute difference and the PSNR; a frame fails when the
+// differing pixels exceed --max-percent of the frame. Only decodes images, so no GL context is needed.
+//
+// Usage: "Frame Diff.exe" [--tolerance N] [--max-percent P] [--diff DIR] GOLDEN_DIR CAPTURE_DIR
+//        --tolerance  channel difference (0-255) still counted as equal, default 2
+//        --max-percent share of differing pixels a frame may have, default 0.05
+//        --diff       write an image per failed frame to DIR: differing pixels red over the golden
+// Exits with 0 when every frame passes, 1 otherwise.
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    // How far a captured frame is from its golden
+    struct FrameDifference {
+        std::size_t differingPixels = 0;
+        std::size_t totalPixels = 0;
+        int maxChannelDifference = 0;
+        double meanAbsoluteDifference = 0; // Per channel, on the 0-255 scale
+        double psnr = 0;                   // In dB, infinite for identical frames
+
+        double differingPercent() const {
+            return totalPixels == 0 ? 0 : 100.0 * differingPixels / totalPixels;
+        }
+    };
+
+    // Function to compare two images of the same size, optionally drawing the differences into diffImage
+    FrameDifference compareImages(const sf::Image& golden, const sf::Image& captured, int tolerance, sf::Image* diffImage) {
+        FrameDifference difference;
+        sf::Vector2u size = golden.getSize();
+        const sf::Uint8* goldenPixels = golden.getPixelsPtr();
+        const sf::Uint8* capturedPixels = captured.getPixelsPtr();
+        difference.totalPixels = static_cast<std::size_t>(size.x) * size.y;
+        if (diffImage) {
+            diffImage->create(size.x, size.y);
+        }
+
+        double absoluteSum = 0;
+        double squaredSum = 0;
+        for (std::size_t pixel = 0; pixel < difference.totalPixels; ++pixel) {
+            int pixelDifference = 0;
+            for (std::size_t channel = 0; channel < 4; ++channel) {
+                int channelDifference = std::abs(goldenPixels[pixel * 4 + channel] - capturedPixels[pixel * 4 + channel]);
+                pixelDifference = std::max(pixelDifference, channelDifference);
+                absoluteSum += channelDifference;
+                squaredSum += static_cast<double>(channelDifference) * channelDifference;
+            }
+            difference.maxChannelDifference = std::max(difference.maxChannelDifference, pixelDifference);
+            bool differs = pixelDifference > tolerance;
+            if (differs) {
+                difference.differingPixels++;
+            }
+
+            if (diffImage) {
+                unsigned x = static_cast<unsigned>(pixel % size.x);
+                unsigned y = static_cast<unsigned>(pixel / size.x);
+                if (differs) {
+                    diffImage->setPixel(x, y, sf::Color::Red);
+                }
+                else {
+                    // The golden, darkened and grey, so the red stands out
+                    const sf::Uint8* rgb = goldenPixels + pixel * 4;
+                    sf::Uint8 grey = static_cast<sf::Uint8>((rgb[0] + rgb[1] + rgb[2]) / 9);
+                    diffImage->setPixel(x, y, sf::Color(grey, grey, grey));
+                }
+            }
+        }
+
+        double channelCount = static_cast<double>(difference.totalPixels) * 4;
+        if (channelCount > 0) {
+            difference.meanAbsoluteDifference = absoluteSum / channelCount;
+            double meanSquared = squaredSum / channelCount;
+            difference.psnr = meanSquared == 0 ? INFINITY : 10.0 * std::log10(255.0 * 255.0 / meanSquared);
+        }
+        return difference;
+    }
+
+    // Function to list the PNG files of a directory by name
+    std::vector<std::filesystem::path> listFrames(const std::filesystem::path& directory) {
+        std::vector<std::filesystem::path> frames;
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".png") {
+                frames.push_back(entry.path());
+            }
+        }
+        if (error) {
+            std::cerr << "Error reading " << directory.string() << ": " << error.message() << "\n";
+        }
+        std::sort(frames.begin(), frames.end());
+        return frames;
+    }
+}
+
+int main(int argc, char** argv) {
+    int tolerance = 2;
+    double maxPercent = 0.05;
+    std::string diffDirectory;
+    std::vector<std::string> directories;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tolerance" && i + 1 < argc) {
+            tolerance = std::atoi(argv[++i]);
+        }
+        else if (arg == "--max-percent" && i + 1 < argc) {
+            maxPercent = std::atof(argv[++i]);
+        }
+        else if (arg == "--diff" && i + 1 < argc) {
+            diffDirectory = argv[++i];
+        }
+        else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+        else {
+            directories.push_back(arg);
+        }
+    }
+    if (directories.size() != 2) {
+        std::cerr << "Usage: \"Frame Diff.exe\" [--tolerance N] [--max-percent P] [--diff DIR] GOLDEN_DIR CAPTURE_DIR\n";
+        return 1;
+    }
+
+    std::filesystem::path goldenDirectory = directories[0];
+    std::filesystem::path captureDirectory = directories[1];
+    std::vector<std::filesystem::path> goldens = listFrames(goldenDirectory);
+    if (goldens.empty()) {
+        std::cerr << "Error: No golden frames in " << goldenDirectory.string() << "\n";
+        return 1;
+    }
+    if (!diffDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(diffDirectory, error);
+    }
+
+    std::size_t failures = 0;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const std::filesystem::path& goldenFile : goldens) {
+        std::string name = goldenFile.filename().string();
+        std::filesystem::path capturedFile = captureDirectory / goldenFile.filename();
+
+        sf::Image golden;
+        sf::Image captured;
+        if (!golden.loadFromFile(goldenFile.string()) || !captured.loadFromFile(capturedFile.string())) {
+            std::cout << name << ": FAIL, missing or unreadable capture\n";
+            failures++;
+            continue;
+        }
+        if (golden.getSize() != captured.getSize()) {
+            std::cout << name << ": FAIL, captured at " << captured.getSize().x << "x" << captured.getSize().y
+                << ", golden is " << golden.getSize().x << "x" << golden.getSize().y << "\n";
+            failures++;
+            continue;
+        }
+
+        sf::Image diffImage;
+        FrameDifference difference = compareImages(golden, captured, tolerance, diffDirectory.empty() ? nullptr : &diffImage);
+        bool passed = difference.differingPercent() <= maxPercent;
+        std::cout << name << ": " << (passed ? "ok" : "FAIL") << ", " << difference.differingPixels << " pixels differ ("
+            << difference.differingPercent() << "%), max " << difference.maxChannelDifference
+            << ", mean " << difference.meanAbsoluteDifference << ", PSNR ";
+        if (std::isinf(difference.psnr)) {
+            std::cout << "inf\n";
+        }
+        else {
+            std::cout << std::setprecision(1) << difference.psnr << std::setprecision(3) << " dB\n";
+        }
+
+        if (!passed) {
+            failures++;
+            if (!diffDirectory.empty()) {
+                diffImage.saveToFile((std::filesystem::path(diffDirectory) / goldenFile.filename()).string());
+            }
+        }
+    }
+
+    std::cout << (goldens.size() - failures) << " of " << goldens.size() << " frames match\n";
+    return failures == 0 ? 0 : 1;
+}
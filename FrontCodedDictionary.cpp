@@ -0,0 +1,175 @@
+#include "FrontCodedDictionary.h"
+#include <algorithm>
+
+namespace {
+    void writeVarint(std::vector<std::uint8_t>& out, std::size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::size_t readVarint(const std::uint8_t* data, std::size_t& position) {
+        std::size_t value = 0;
+        int shift = 0;
+        std::uint8_t byte;
+        do {
+            byte = data[position++];
+            value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        return value;
+    }
+
+    // First eight bytes of a key as a big-endian number, zero padded, so comparing two prefixes
+    // orders keys like comparing the strings does, up to ties
+    std::uint64_t keyPrefix(std::string_view key) {
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < 8; ++i) {
+            prefix = (prefix << 8) | (i < key.size() ? static_cast<unsigned char>(key[i]) : 0);
+        }
+        return prefix;
+    }
+
+    std::size_t commonPrefix(std::string_view a, std::string_view b) {
+        std::size_t length = std::min(a.size(), b.size());
+        std::size_t i = 0;
+        while (i < length && a[i] == b[i]) {
+            i++;
+        }
+        return i;
+    }
+}
+
+FrontCodedDictionary::FrontCodedDictionary(const AcronymMap& acronyms) {
+    std::vector<const AcronymMap::value_type*> sorted;
+    sorted.reserve(acronyms.size());
+    std::size_t nameBytes = 0;
+    for (const auto& entry : acronyms) {
+        sorted.push_back(&entry);
+        nameBytes += entry.second.size();
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const AcronymMap::value_type* a, const AcronymMap::value_type* b) { return a->first < b->first; });
+
+    count = static_cast<std::uint32_t>(sorted.size());
+    blockOffsets.reserve((sorted.size() + blockSize - 1) / blockSize);
+    headPrefixes.reserve(blockOffsets.capacity());
+    names.reserve(nameBytes);
+    nameOffsets.reserve(sorted.size() + 1);
+
+    std::string_view previous;
+    for (std::size_t rank = 0; rank < sorted.size(); ++rank) {
+        std::string_view acronym = sorted[rank]->first;
+        if (rank % blockSize == 0) {
+            blockOffsets.push_back(static_cast<std::uint32_t>(keys.size()));
+            headPrefixes.push_back(keyPrefix(acronym));
+            writeVarint(keys, acronym.size());
+            keys.insert(keys.end(), acronym.begin(), acronym.end());
+        }
+        else {
+            std::size_t shared = commonPrefix(previous, acronym);
+            writeVarint(keys, shared);
+            writeVarint(keys, acronym.size() - shared);
+            keys.insert(keys.end(), acronym.begin() + shared, acronym.end());
+        }
+        previous = acronym;
+
+        nameOffsets.push_back(static_cast<std::uint32_t>(names.size()));
+        names.insert(names.end(), sorted[rank]->second.begin(), sorted[rank]->second.end());
+    }
+    nameOffsets.push_back(static_cast<std::uint32_t>(names.size()));
+    keys.shrink_to_fit();
+}
+
+std::string_view FrontCodedDictionary::blockHead(std::uint32_t block, std::size_t& position) const {
+    position = blockOffsets[block];
+    std::size_t length = readVarint(keys.data(), position);
+    std::string_view head(reinterpret_cast<const char*>(keys.data()) + position, length);
+    position += length;
+    return head;
+}
+
+std::uint32_t FrontCodedDictionary::find(std::string_view acronym) const {
+    if (count == 0) {
+        return notFound;
+    }
+
+    // Last block whose head is <= acronym. The heads' prefixes sit in one array and settle most
+    // comparisons; only equal prefixes need the head itself.
+    std::uint64_t prefix = keyPrefix(acronym);
+    std::size_t position = 0;
+    std::uint32_t low = 0;
+    std::uint32_t high = static_cast<std::uint32_t>(blockOffsets.size());
+    while (high - low > 1) {
+        std::uint32_t middle = low + (high - low) / 2;
+        if (headPrefixes[middle] != prefix ? headPrefixes[middle] < prefix : blockHead(middle, position) <= acronym) {
+            low = middle;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    std::string_view head = blockHead(low, position);
+    if (head == acronym) {
+        return low * blockSize;
+    }
+    if (head > acronym) {
+        return notFound; // Before the first key
+    }
+
+    // Walk the block. matched is how much of acronym the previous key shares; the previous key is
+    // smaller than acronym, so the comparison only has to look at bytes past the shared prefix.
+    std::size_t matched = commonPrefix(head, acronym);
+    std::uint32_t end = std::min(count, (low + 1) * blockSize);
+    for (std::uint32_t rank = low * blockSize + 1; rank < end; ++rank) {
+        std::size_t shared = readVarint(keys.data(), position);
+        std::size_t suffixLength = readVarint(keys.data(), position);
+        const char* suffix = reinterpret_cast<const char*>(keys.data()) + position;
+        position += suffixLength;
+
+        if (shared < matched) {
+            return notFound; // This key differs from the previous one before acronym does, so it is larger
+        }
+        if (shared > matched) {
+            continue; // Still differs from acronym where the previous key did, so it is smaller
+        }
+
+        std::size_t i = 0;
+        while (i < suffixLength && matched + i < acronym.size() && suffix[i] == acronym[matched + i]) {
+            i++;
+        }
+        if (i == suffixLength && matched + i == acronym.size()) {
+            return rank;
+        }
+        if (i == suffixLength || (matched + i < acronym.size() && static_cast<unsigned char>(suffix[i]) < static_cast<unsigned char>(acronym[matched + i]))) {
+            matched += i; // Smaller: a prefix of acronym or a smaller byte
+            continue;
+        }
+        return notFound; // Larger
+    }
+    return notFound;
+}
+
+std::string FrontCodedDictionary::key(std::uint32_t rank) const {
+    std::size_t position = 0;
+    std::string acronym(blockHead(rank / blockSize, position));
+    for (std::uint32_t i = rank / blockSize * blockSize; i < rank; ++i) {
+        std::size_t shared = readVarint(keys.data(), position);
+        std::size_t suffixLength = readVarint(keys.data(), position);
+        acronym.resize(shared);
+        acronym.append(reinterpret_cast<const char*>(keys.data()) + position, suffixLength);
+        position += suffixLength;
+    }
+    return acronym;
+}
+
+std::size_t FrontCodedDictionary::keyBytes() const {
+    return keys.capacity() + blockOffsets.capacity() * sizeof(std::uint32_t) + headPrefixes.capacity() * sizeof(std::uint64_t);
+}
+
+std::size_t FrontCodedDictionary::sizeInBytes() const {
+    return keyBytes() + names.capacity() + nameOffsets.capacity() * sizeof(std::uint32_t);
+}
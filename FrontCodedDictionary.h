@@ -0,0 +1,60 @@
+#pragma once
+#include "Acronyms.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A sorted, read-only acronym -> full name dictionary with front-coded keys.
+//
+// Keys are sorted and cut into blocks of blockSize. The first key of a block is stored whole; every
+// other key only stores how many leading bytes it shares with the key before it and the bytes that
+// follow, both lengths as varints. Acronyms share long prefixes (AES, AES256, AESGCM), so most keys
+// take two or three bytes. A lookup binary-searches the block heads, mostly on a packed array of
+// their first eight bytes, and then walks one block comparing incrementally, without rebuilding
+// any key.
+//
+// Full names are stored back to back with a 32-bit offset per key. Entries are numbered by key
+// rank, so iteration is in sorted order, not in the deck's iteration order.
+//
+// Only the benchmarks use it for now. In the game the round's AcronymMap stays alive for the
+// scheduler, tag index and shuffled deck, so a dictionary built next to it would add memory rather
+// than replace it; it can back the round once those read from card numbers instead of the map.
+class FrontCodedDictionary {
+public:
+    static constexpr std::uint32_t notFound = 0xFFFFFFFF;
+    static constexpr std::uint32_t blockSize = 16;
+
+    FrontCodedDictionary() = default;
+
+    // Function to build the dictionary from a deck
+    explicit FrontCodedDictionary(const AcronymMap& acronyms);
+
+    std::uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Function to find the rank of an (upper-case) acronym, notFound if it is not in the dictionary
+    std::uint32_t find(std::string_view acronym) const;
+
+    // Function to decode the acronym of a rank
+    std::string key(std::uint32_t rank) const;
+
+    std::string_view fullName(std::uint32_t rank) const {
+        return std::string_view(names.data() + nameOffsets[rank], nameOffsets[rank + 1] - nameOffsets[rank]);
+    }
+
+    // Function to report the memory held by the keys, the block index and the full names
+    std::size_t sizeInBytes() const;
+    std::size_t keyBytes() const; // Keys and block index only
+
+private:
+    std::string_view blockHead(std::uint32_t block, std::size_t& position) const;
+
+    std::vector<std::uint8_t> keys;          // Front-coded blocks, back to back
+    std::vector<std::uint32_t> blockOffsets; // Where each block starts in keys
+    std::vector<std::uint64_t> headPrefixes; // First eight bytes of each block's head, for the search
+    std::vector<char> names;                 // Full names in rank order
+    std::vector<std::uint32_t> nameOffsets;  // count + 1 offsets into names
+    std::uint32_t count = 0;
+};
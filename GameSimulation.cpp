@@ -0,0 +1,208 @@
+#include "GameSimulation.h"
+#include <SFML/Graphics/Image.hpp>
+#include <algorithm> // For std::transform
+#include <cctype>
+#include <iostream>
+#include <iterator>  // For std::advance
+
+namespace {
+    const std::int64_t spaceshipStepsPerSecond = 60; // The spaceship falls in fixed 60 Hz steps
+
+    // Function to pick a random spaceship texture and horizontal position at the top
+    void respawnSpaceship(GameState& game) {
+        if (!game.spaceshipSizes.empty()) {
+            std::uniform_int_distribution<std::size_t> textureDist(0, game.spaceshipSizes.size() - 1);
+            game.spaceshipTexture = textureDist(game.rng);
+        }
+
+        float width = game.spaceshipSizes.empty() ? 0.0f : game.spaceshipSizes[game.spaceshipTexture].x;
+        int range = std::max(1, static_cast<int>(game.playfieldSize.x - width));
+        std::uniform_int_distribution<int> xDist(0, range - 1);
+        game.spaceshipPosition = sf::Vector2f(static_cast<float>(xDist(game.rng)), 0.0f);
+    }
+
+    // Function to end the round if the timer ran out or the spaceship touches the bottom of the window
+    void checkGameOver(GameState& game) {
+        float height = game.spaceshipSizes.empty() ? 0.0f : game.spaceshipSizes[game.spaceshipTexture].y;
+        if (game.timer <= 0 || game.spaceshipPosition.y + height >= game.playfieldSize.y) {
+            game.feedback = "Game Over! Final Score: " + std::to_string(game.score);
+            game.gameOver = true;
+        }
+    }
+}
+
+bool loadSpaceshipSizes(std::vector<sf::Vector2f>& spaceshipSizes, const AssetLookup& findInMemory) {
+    spaceshipSizes.clear();
+    for (int i = 1; i <= 4; ++i) {
+        sf::Image image;
+        std::string filePath = "Textures/" + std::to_string(i) + ".png";
+        const void* data = nullptr;
+        std::size_t size = 0;
+        bool inMemory = findInMemory && findInMemory(filePath, data, size);
+        if (!(inMemory ? image.loadFromMemory(data, size) : image.loadFromFile(filePath))) {
+            std::cerr << "Error loading spaceship image " << i << " from " << filePath << "\n";
+            return false;
+        }
+        spaceshipSizes.emplace_back(image.getSize().x * spaceshipScale, image.getSize().y * spaceshipScale);
+    }
+    return true;
+}
+
+void startGame(GameState& game, int gameMode, const AcronymMap& acronyms,
+    const std::vector<sf::Vector2f>& spaceshipSizes, sf::Vector2f playfieldSize, unsigned int seed,
+    QuestionScheduler* scheduler, ShuffledDeck* shuffledDeck) {
+    game = GameState();
+    game.gameMode = gameMode;
+    game.scheduler = scheduler;
+    game.shuffledDeck = shuffledDeck;
+    game.playfieldSize = playfieldSize;
+    game.spaceshipSizes = spaceshipSizes;
+    game.rng.seed(seed);
+
+    respawnSpaceship(game);
+    selectRandomAcronym(game, acronyms);
+}
+
+void selectRandomAcronym(GameState& game, const AcronymMap& acronyms) {
+    if (acronyms.empty()) {
+        return;
+    }
+
+    if (game.scheduler) {
+        game.currentCard = game.scheduler->pickNext(game.rng);
+        game.currentCardAnswered = false;
+        game.currentAcronym = game.scheduler->acronym(game.currentCard);
+        game.currentFullName = game.scheduler->fullName(game.currentCard);
+    }
+    else if (game.shuffledDeck) {
+        const AcronymMap::value_type& entry = game.shuffledDeck->next();
+        game.currentAcronym = entry.first;
+        game.currentFullName = entry.second;
+    }
+    else {
+        std::uniform_int_distribution<std::size_t> indexDist(0, acronyms.size() - 1);
+        auto it = acronyms.begin();
+        std::advance(it, indexDist(game.rng));
+        game.currentAcronym = it->first;
+        game.currentFullName = it->second;
+    }
+
+    // Term mode shows the acronym, the other modes show the full name
+    game.questionText = (game.gameMode == 2) ? game.currentAcronym : game.currentFullName;
+}
+
+bool isCorrectAnswer(const GameState& game, const AcronymMap& acronyms) {
+    if (game.gameMode == 2) {
+        // Term mode: the input has to match the full name of the current acronym
+        std::string fullName = game.currentFullName;
+        std::transform(fullName.begin(), fullName.end(), fullName.begin(), ::toupper);
+        return game.userInput == fullName;
+    }
+
+    // Acronym and challenge mode accept any acronym in the deck
+    return acronyms.find(game.userInput) != acronyms.end();
+}
+
+void handleTextEntered(GameState& game, const AcronymMap& acronyms, sf::Uint32 unicode) {
+    if (game.gameOver || game.quitRequested) {
+        return;
+    }
+
+    if (unicode == 8) { // Handle backspace
+        if (!game.userInput.empty())
+            game.userInput.pop_back();
+    }
+    else if (unicode == 13) { // Handle enter (check input)
+        std::transform(game.userInput.begin(), game.userInput.end(), game.userInput.begin(), ::toupper);
+
+        bool correct = isCorrectAnswer(game, acronyms);
+        if (game.scheduler && !game.currentCardAnswered && (correct || game.userInput != "Q")) {
+            game.scheduler->answer(game.currentCard, correct);
+            game.currentCardAnswered = true;
+        }
+
+        if (correct) {
+            game.feedback = "Hit!";
+            game.score += 100; // Increment score by 100
+            game.timer += 5;   // Add 5 seconds to the timer
+
+            // The explosion starts where the spaceship was
+            sf::Vector2f size = game.spaceshipSizes.empty() ? sf::Vector2f() : game.spaceshipSizes[game.spaceshipTexture];
+            game.hitPosition = game.spaceshipPosition + size / 2.0f;
+            game.hitCount++;
+
+            respawnSpaceship(game);
+            selectRandomAcronym(game, acronyms);
+        }
+        else if (game.userInput == "Q") {
+            game.quitRequested = true;
+        }
+        else {
+            game.feedback = (game.gameMode == 2) ? "Incorrect! Try again." : "Missed!";
+            game.score -= 100;                // Deduct 100 points
+            game.spaceshipPosition.y += 45.0f; // Move down 45 pixels
+        }
+
+        // Clear input for next round
+        game.userInput.clear();
+
+        // A miss can push the spaceship to the bottom straight away
+        checkGameOver(game);
+    }
+    else if (unicode >= 32 && unicode <= 126) {
+        // Only handle printable characters
+        game.userInput += static_cast<char>(unicode);
+    }
+}
+
+void advanceSimulation(GameState& game, std::int64_t elapsedMillis) {
+    if (elapsedMillis <= 0 || game.gameOver || game.quitRequested) {
+        return;
+    }
+
+    // The spaceship falls in acronym mode and falls faster in challenge mode
+    float fallSpeed = 0.0f;
+    if (game.gameMode == 1) {
+        fallSpeed = 0.75f;
+    }
+    else if (game.gameMode == 3) {
+        fallSpeed = 1.75f;
+    }
+
+    // Walk from one timer tick or spaceship step to the next, so the round ends at the same
+    // game time however the elapsed time was split into calls
+    std::int64_t targetMillis = game.elapsedMillis + elapsedMillis;
+    while (game.elapsedMillis < targetMillis && !game.gameOver) {
+        std::int64_t nextSecond = (game.elapsedMillis / 1000 + 1) * 1000;
+        std::int64_t nextStepIndex = game.elapsedMillis * spaceshipStepsPerSecond / 1000 + 1;
+        std::int64_t nextStep = (nextStepIndex * 1000 + spaceshipStepsPerSecond - 1) / spaceshipStepsPerSecond;
+
+        std::int64_t previousMillis = game.elapsedMillis;
+        game.elapsedMillis = std::min(targetMillis, std::min(nextSecond, nextStep));
+
+        // Count the timer down once per whole second
+        if (game.elapsedMillis / 1000 != previousMillis / 1000) {
+            game.timer--;
+        }
+        if (game.elapsedMillis * spaceshipStepsPerSecond / 1000 != previousMillis * spaceshipStepsPerSecond / 1000) {
+            game.spaceshipPosition.y += fallSpeed;
+        }
+
+        checkGameOver(game);
+    }
+}
+
+void writeSnapshot(const GameState& game, FrameSnapshot& snapshot) {
+    snapshot.spaceshipPosition = game.spaceshipPosition;
+    snapshot.spaceshipTexture = game.spaceshipTexture;
+    snapshot.questionText = game.questionText;
+    snapshot.userInput = game.userInput;
+    snapshot.feedback = game.feedback;
+    snapshot.timer = game.timer;
+    snapshot.score = game.score;
+    snapshot.gameOver = game.gameOver;
+    snapshot.quitRequested = game.quitRequested;
+    snapshot.hitCount = game.hitCount;
+    snapshot.hitPosition = game.hitPosition;
+    snapshot.lastInputSequence = game.lastInputSequence;
+}
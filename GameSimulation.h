@@ -0,0 +1,117 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Config.hpp>
+#include "Acronyms.h"
+#include "QuestionScheduler.h"
+#include "ShuffledDeck.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+// Everything the gameplay screen needs to run one round.
+// It has no window or texture references so it can be stepped from any thread.
+struct GameState {
+    int gameMode = 1;
+    int score = 0;
+    int timer = 30; // Seconds left in the round
+
+    std::string userInput;
+    std::string currentAcronym;
+    std::string currentFullName;
+    std::string questionText; // What is shown in the combined box (full name or acronym)
+    std::string feedback;
+
+    // Optional spaced-repetition scheduler; without one questions are drawn uniformly at random
+    QuestionScheduler* scheduler = nullptr;
+    std::uint32_t currentCard = QuestionScheduler::noCard;
+    bool currentCardAnswered = false; // Only the first answer to a question is reported to the scheduler
+
+    // Optional shuffled deck, used when there is no scheduler; every card comes up once per cycle
+    ShuffledDeck* shuffledDeck = nullptr;
+
+    sf::Vector2f spaceshipPosition;
+    std::size_t spaceshipTexture = 0;
+
+    bool gameOver = false;
+    bool quitRequested = false;
+
+    // Correct answers so far and the center of the spaceship last hit, for the explosion effect
+    std::uint32_t hitCount = 0;
+    sf::Vector2f hitPosition;
+
+    // Sequence number of the last InputEvent applied, used to match input to displayed frames
+    std::uint64_t lastInputSequence = 0;
+
+    // Playfield and spaceship dimensions used for placement and the game over check
+    sf::Vector2f playfieldSize;
+    std::vector<sf::Vector2f> spaceshipSizes;
+
+    // Game time in whole milliseconds. Keeping it integral means the outcome only depends on
+    // when inputs were applied, not on how the elapsed time was split into steps (see Replay.h).
+    std::int64_t elapsedMillis = 0;
+
+    std::mt19937 rng;
+};
+
+// Immutable view of a GameState handed from the simulation thread to the render thread
+struct FrameSnapshot {
+    sf::Vector2f spaceshipPosition;
+    std::size_t spaceshipTexture = 0;
+    std::string questionText;
+    std::string userInput;
+    std::string feedback;
+    int timer = 0;
+    int score = 0;
+    bool gameOver = false;
+    bool quitRequested = false;
+    std::uint32_t hitCount = 0; // Changes with every hit, so the render thread sees each new one
+    sf::Vector2f hitPosition;
+    std::uint64_t lastInputSequence = 0;
+};
+
+// A typed character waiting for the simulation thread
+struct InputEvent {
+    sf::Uint32 unicode = 0;
+    std::uint64_t sequence = 0;       // Increases by one for every event polled in a round
+    std::int64_t timestampMicros = 0; // When the event was polled from the window
+};
+
+// Spaceships are drawn at half the size of their textures
+const float spaceshipScale = 0.5f;
+
+// Function to find an asset in memory, e.g. in the asset archive; false if it has to be read from disk
+using AssetLookup = std::function<bool(const std::string& file, const void*& data, std::size_t& size)>;
+
+// Function to read the drawn sizes of Textures/1.png to 4.png without creating GPU textures. Images
+// findInMemory finds are decoded from memory, the others are read from disk.
+bool loadSpaceshipSizes(std::vector<sf::Vector2f>& spaceshipSizes, const AssetLookup& findInMemory = nullptr);
+
+// Function to read the monotonic clock used for input timestamps
+inline std::int64_t steadyMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Function to reset the state for a new round and pick the first acronym.
+// With a scheduler, questions follow it instead of being drawn uniformly from the deck; with a
+// shuffled deck (and no scheduler), they walk through the deck without repeats.
+void startGame(GameState& game, int gameMode, const AcronymMap& acronyms,
+    const std::vector<sf::Vector2f>& spaceshipSizes, sf::Vector2f playfieldSize, unsigned int seed,
+    QuestionScheduler* scheduler = nullptr, ShuffledDeck* shuffledDeck = nullptr);
+
+// Function to pick the next acronym (random, scheduled or shuffled) and update the question text
+void selectRandomAcronym(GameState& game, const AcronymMap& acronyms);
+
+// Function to check the entered (upper-cased) text against the current question
+bool isCorrectAnswer(const GameState& game, const AcronymMap& acronyms);
+
+// Function to apply one TextEntered character (backspace, enter or printable)
+void handleTextEntered(GameState& game, const AcronymMap& acronyms, sf::Uint32 unicode);
+
+// Function to advance the timer and the falling spaceship by the elapsed time
+void advanceSimulation(GameState& game, std::int64_t elapsedMillis);
+
+// Function to copy the drawable parts of the state into a snapshot
+void writeSnapshot(const GameState& game, FrameSnapshot& snapshot);
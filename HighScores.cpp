@@ -0,0 +1,285 @@
+#include "HighScores.h"
+#include "Profiler.h"
+#include <sqlite3.h>
+#include <iostream>
+
+namespace {
+    std::string databasePath = "highscores.db";
+
+    // Concurrent writers (e.g. the load generator) wait this long for the database lock
+    const int busyTimeoutMillis = 5000;
+
+    // Function to check whether a table already has a column
+    bool hasColumn(sqlite3* db, const std::string& table, const std::string& column) {
+        std::string sql = "PRAGMA table_info(" + table + ");";
+        sqlite3_stmt* stmt;
+        bool found = false;
+
+        if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {
+                if (column == reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1))) {
+                    found = true;
+                    break;
+                }
+            }
+        }
+
+        sqlite3_finalize(stmt);
+        return found;
+    }
+}
+
+void setDatabasePath(const std::string& path) {
+    databasePath = path;
+}
+
+void initializeDatabase() {
+    sqlite3* db;
+    int rc = sqlite3_open(databasePath.c_str(), &db);
+    if (rc) {
+        std::cerr << "Can't open database: " << sqlite3_errmsg(db) << "\n";
+    }
+    else {
+        std::cout << "Opened database successfully\n";
+    }
+
+    const char* createTableSQL = R"(
+        CREATE TABLE IF NOT EXISTS HighScores (
+            id INTEGER PRIMARY KEY AUTOINCREMENT,
+            player_name TEXT NOT NULL,
+            score INTEGER NOT NULL,
+            date_time TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+        );
+    )";
+
+    char* errorMessage;
+    rc = sqlite3_exec(db, createTableSQL, nullptr, nullptr, &errorMessage);
+    if (rc != SQLITE_OK) {
+        std::cerr << "SQL error: " << errorMessage << "\n";
+        sqlite3_free(errorMessage);
+    }
+    else {
+        std::cout << "Table created successfully\n";
+    }
+
+    // Input-to-display latency summary of the session, added to databases created before it existed
+    const char* latencyColumns[] = { "latency_samples", "latency_p50_us", "latency_p90_us", "latency_p99_us", "latency_max_us" };
+    for (const char* column : latencyColumns) {
+        if (!hasColumn(db, "HighScores", column)) {
+            std::string alterTableSQL = std::string("ALTER TABLE HighScores ADD COLUMN ") + column + " INTEGER;";
+            rc = sqlite3_exec(db, alterTableSQL.c_str(), nullptr, nullptr, &errorMessage);
+            if (rc != SQLITE_OK) {
+                std::cerr << "SQL error: " << errorMessage << "\n";
+                sqlite3_free(errorMessage);
+            }
+        }
+    }
+
+    // Spaced-repetition state per player (see QuestionScheduler.h)
+    const char* createScheduleTablesSQL = R"(
+        CREATE TABLE IF NOT EXISTS CardSchedules (
+            player_name TEXT NOT NULL,
+            acronym TEXT NOT NULL,
+            due INTEGER NOT NULL,
+            interval INTEGER NOT NULL,
+            ease INTEGER NOT NULL,
+            repetitions INTEGER NOT NULL,
+            PRIMARY KEY (player_name, acronym)
+        );
+        CREATE TABLE IF NOT EXISTS PlayerProgress (
+            player_name TEXT PRIMARY KEY,
+            review_step INTEGER NOT NULL
+        );
+    )";
+    rc = sqlite3_exec(db, createScheduleTablesSQL, nullptr, nullptr, &errorMessage);
+    if (rc != SQLITE_OK) {
+        std::cerr << "SQL error: " << errorMessage << "\n";
+        sqlite3_free(errorMessage);
+    }
+
+    sqlite3_close(db);
+}
+
+void insertScore(const std::string& playerName, int score, const LatencySummary& displayLatency) {
+    PROFILE_SCOPE("insertScore");
+
+    sqlite3* db;
+    sqlite3_open(databasePath.c_str(), &db);
+    sqlite3_busy_timeout(db, busyTimeoutMillis);
+
+    // Check if the score already exists for this player
+    std::string checkSql = "SELECT COUNT(*) FROM highscores WHERE player_name = '" + playerName + "' AND score = " + std::to_string(score) + ";";
+    
+    sqlite3_stmt* stmt;
+    sqlite3_prepare_v2(db, checkSql.c_str(), -1, &stmt, nullptr);
+    int result = sqlite3_step(stmt);
+
+    if (result == SQLITE_ROW) {
+        int count = sqlite3_column_int(stmt, 0);
+        if (count > 0) {
+            // If the score is already in the database, skip the insert
+            std::cout << "Score already exists for player: " << playerName << " with score: " << score << std::endl;
+            sqlite3_finalize(stmt);
+            sqlite3_close(db);
+            return;
+        }
+    }
+
+    sqlite3_finalize(stmt);
+
+    // If the score does not exist, insert the score into the database
+    std::string sql = "INSERT INTO HighScores (player_name, score, latency_samples, latency_p50_us, latency_p90_us, latency_p99_us, latency_max_us) VALUES ('"
+        + playerName + "', " + std::to_string(score) + ", "
+        + std::to_string(displayLatency.count) + ", " + std::to_string(displayLatency.p50) + ", " + std::to_string(displayLatency.p90) + ", "
+        + std::to_string(displayLatency.p99) + ", " + std::to_string(displayLatency.max) + ");";
+
+    char* errMessage = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), 0, 0, &errMessage) != SQLITE_OK) {
+        std::cerr << "Error inserting score into database: " << errMessage << std::endl;
+        sqlite3_free(errMessage);
+    }
+
+    sqlite3_close(db);
+
+}
+
+
+
+
+std::vector<std::pair<std::string, int>> getTopScores() {
+    PROFILE_SCOPE("getTopScores");
+
+    sqlite3* db;
+    sqlite3_open(databasePath.c_str(), &db);
+    sqlite3_busy_timeout(db, busyTimeoutMillis);
+
+    std::vector<std::pair<std::string, int >> topScores;
+
+    std::string sql = "SELECT player_name, score FROM HighScores ORDER BY score DESC LIMIT 10;";
+    sqlite3_stmt* stmt;
+
+    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            std::string playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            int score = sqlite3_column_int(stmt, 1);
+            topScores.emplace_back(playerName, score);
+        }
+    }
+
+    else {
+        std::cerr << "Error querying top scores: " << sqlite3_errmsg(db) << std::endl;
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+
+    return topScores;
+}
+
+std::string getLastPlayerName() {
+    sqlite3* db;
+    sqlite3_open(databasePath.c_str(), &db);
+    sqlite3_busy_timeout(db, busyTimeoutMillis);
+
+    std::string playerName;
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT player_name FROM HighScores ORDER BY id DESC LIMIT 1;", -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+    return playerName;
+}
+
+bool loadCardSchedules(const std::string& playerName, std::uint32_t& reviewStep, std::vector<StoredCard>& cards) {
+    PROFILE_SCOPE("loadCardSchedules");
+
+    sqlite3* db;
+    sqlite3_open(databasePath.c_str(), &db);
+    sqlite3_busy_timeout(db, busyTimeoutMillis);
+
+    reviewStep = 0;
+    cards.clear();
+    bool ok = true;
+
+    sqlite3_stmt* stmt;
+    if (sqlite3_prepare_v2(db, "SELECT review_step FROM PlayerProgress WHERE player_name = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            reviewStep = static_cast<std::uint32_t>(sqlite3_column_int64(stmt, 0));
+        }
+    }
+    else {
+        ok = false;
+    }
+    sqlite3_finalize(stmt);
+
+    if (ok && sqlite3_prepare_v2(db, "SELECT acronym, due, interval, ease, repetitions FROM CardSchedules WHERE player_name = ?;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_TRANSIENT);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            StoredCard card;
+            card.acronym = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            card.schedule.due = static_cast<std::uint32_t>(sqlite3_column_int64(stmt, 1));
+            card.schedule.interval = static_cast<std::uint32_t>(sqlite3_column_int64(stmt, 2));
+            card.schedule.ease = static_cast<std::uint16_t>(sqlite3_column_int(stmt, 3));
+            card.schedule.repetitions = static_cast<std::uint16_t>(sqlite3_column_int(stmt, 4));
+            cards.push_back(card);
+        }
+        sqlite3_finalize(stmt);
+    }
+    else {
+        ok = false;
+    }
+
+    if (!ok) {
+        std::cerr << "Error loading card schedules: " << sqlite3_errmsg(db) << std::endl;
+    }
+    sqlite3_close(db);
+    return ok;
+}
+
+void saveCardSchedules(const std::string& playerName, std::uint32_t reviewStep, const std::vector<StoredCard>& cards) {
+    PROFILE_SCOPE("saveCardSchedules");
+
+    sqlite3* db;
+    sqlite3_open(databasePath.c_str(), &db);
+    sqlite3_busy_timeout(db, busyTimeoutMillis);
+
+    // One transaction for the whole round, so saving costs a single sync however many cards changed
+    sqlite3_exec(db, "BEGIN;", nullptr, nullptr, nullptr);
+
+    sqlite3_stmt* stmt;
+    sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO PlayerProgress (player_name, review_step) VALUES (?, ?);", -1, &stmt, nullptr);
+    sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 2, reviewStep);
+    bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "INSERT OR REPLACE INTO CardSchedules (player_name, acronym, due, interval, ease, repetitions) VALUES (?, ?, ?, ?, ?, ?);", -1, &stmt, nullptr);
+    for (const StoredCard& card : cards) {
+        if (!ok) {
+            break;
+        }
+        sqlite3_bind_text(stmt, 1, playerName.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, card.acronym.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(stmt, 3, card.schedule.due);
+        sqlite3_bind_int64(stmt, 4, card.schedule.interval);
+        sqlite3_bind_int(stmt, 5, card.schedule.ease);
+        sqlite3_bind_int(stmt, 6, card.schedule.repetitions);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    if (ok) {
+        sqlite3_exec(db, "COMMIT;", nullptr, nullptr, nullptr);
+    }
+    else {
+        std::cerr << "Error saving card schedules: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+    sqlite3_close(db);
+}
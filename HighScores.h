@@ -0,0 +1,28 @@
+#pragma once
+#include "LatencyHistogram.h"
+#include "QuestionScheduler.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Function to point the score store at a different SQLite file (default "highscores.db")
+void setDatabasePath(const std::string& path);
+
+// Function to Initialize the Database, creating or upgrading the HighScores table
+void initializeDatabase();
+
+// Function to save a finished session unless the same player already has the same score
+void insertScore(const std::string& playerName, int score, const LatencySummary& displayLatency);
+
+// Function to get top scores from the database
+std::vector<std::pair<std::string, int>> getTopScores();
+
+// Function to get the name saved with the most recent score, empty if there is none
+std::string getLastPlayerName();
+
+// Function to load a player's spaced-repetition state, returns false on a database error
+bool loadCardSchedules(const std::string& playerName, std::uint32_t& reviewStep, std::vector<StoredCard>& cards);
+
+// Function to save a player's review step and the given cards in one transaction
+void saveCardSchedules(const std::string& playerName, std::uint32_t reviewStep, const std::vector<StoredCard>& cards);
@@ -0,0 +1,53 @@
+#include "InternedDeck.h"
+#include <functional>
+
+InternedDeck::InternedDeck(const AcronymMap& acronyms) {
+    // Size everything up front, so the arena is allocated once and filled by appending
+    std::size_t textBytes = 0;
+    for (const auto& entry : acronyms) {
+        textBytes += entry.first.size() + entry.second.size();
+    }
+    arena.reserve(textBytes, acronyms.size());
+    cards.reserve(acronyms.size());
+
+    std::size_t slotCount = 16;
+    while (slotCount < acronyms.size() * 2) {
+        slotCount *= 2;
+    }
+    slots.assign(slotCount, noCard);
+
+    for (const auto& entry : acronyms) {
+        Card card;
+        if (!arena.append(entry.first, card.acronym) || !arena.intern(entry.second, card.fullName)) {
+            break; // More than 4 GB of text; the rest of the deck is left out
+        }
+
+        std::size_t slot = std::hash<std::string_view>()(entry.first) & (slots.size() - 1);
+        while (slots[slot] != noCard) {
+            slot = (slot + 1) & (slots.size() - 1);
+        }
+        slots[slot] = static_cast<std::uint32_t>(cards.size());
+        cards.push_back(card);
+    }
+
+    // The intern table is only needed while building
+    arena.shrinkToFit();
+}
+
+std::uint32_t InternedDeck::find(std::string_view acronym) const {
+    if (slots.empty()) {
+        return noCard;
+    }
+    std::size_t slot = std::hash<std::string_view>()(acronym) & (slots.size() - 1);
+    while (slots[slot] != noCard) {
+        if (arena.view(cards[slots[slot]].acronym) == acronym) {
+            return slots[slot];
+        }
+        slot = (slot + 1) & (slots.size() - 1);
+    }
+    return noCard;
+}
+
+std::size_t InternedDeck::sizeInBytes() const {
+    return arena.sizeInBytes() + cards.capacity() * sizeof(Card) + slots.capacity() * sizeof(std::uint32_t);
+}
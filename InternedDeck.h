@@ -0,0 +1,51 @@
+#pragma once
+#include "Acronyms.h"
+#include "TextArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// A read-only deck whose text lives in one TextArena.
+//
+// Each card is two TextRefs (16 bytes) and the lookup table is a power-of-two array of card
+// numbers, at most half full, probed linearly. Compared with an AcronymMap there is no node,
+// bucket or std::string per card and no heap block per long full name, and consecutive cards'
+// text is adjacent in memory. Full names are interned, so repeated ones are stored once.
+//
+// Cards are numbered in the iteration order of the AcronymMap the deck was built from, the same
+// numbering QuestionScheduler, ShuffledDeck and TagIndex use.
+//
+// Only the benchmarks use it for now. Those three, the question layouts and hashDeck() still read
+// the round's AcronymMap, so an interned copy next to it would hold the deck's text twice; the
+// round can move to it once they read card numbers and views into the arena instead.
+class InternedDeck {
+public:
+    static constexpr std::uint32_t noCard = 0xFFFFFFFF;
+
+    InternedDeck() = default;
+
+    // Function to copy a deck into the arena
+    explicit InternedDeck(const AcronymMap& acronyms);
+
+    std::uint32_t size() const { return static_cast<std::uint32_t>(cards.size()); }
+    bool empty() const { return cards.empty(); }
+    std::string_view acronym(std::uint32_t card) const { return arena.view(cards[card].acronym); }
+    std::string_view fullName(std::uint32_t card) const { return arena.view(cards[card].fullName); }
+
+    // Function to find the card of an (upper-case) acronym, noCard if it is not in the deck
+    std::uint32_t find(std::string_view acronym) const;
+
+    // Function to report the memory held by the text, the cards and the lookup table
+    std::size_t sizeInBytes() const;
+
+private:
+    struct Card {
+        TextRef acronym;
+        TextRef fullName;
+    };
+
+    TextArena arena;
+    std::vector<Card> cards;
+    std::vector<std::uint32_t> slots; // Card numbers by acronym hash, noCard where free
+};
@@ -0,0 +1,89 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    buckets.fill(0);
+    totalCount = 0;
+    maxValue = 0;
+}
+
+std::size_t LatencyHistogram::bucketIndex(std::int64_t value) {
+    const std::int64_t linearLimit = std::int64_t(2) << subBucketBits;
+    if (value < linearLimit) {
+        return static_cast<std::size_t>(value);
+    }
+
+    int msb = 0;
+    while ((value >> (msb + 1)) != 0) {
+        ++msb;
+    }
+    int shift = msb - subBucketBits; // value >> shift lands in [32, 64)
+    std::int64_t subBucket = (value >> shift) - (std::int64_t(1) << subBucketBits);
+    return static_cast<std::size_t>(((shift + 1) << subBucketBits) + subBucket);
+}
+
+std::int64_t LatencyHistogram::bucketUpperValue(std::size_t index) {
+    const std::size_t linearLimit = std::size_t(2) << subBucketBits;
+    if (index < linearLimit) {
+        return static_cast<std::int64_t>(index);
+    }
+
+    int shift = static_cast<int>(index >> subBucketBits) - 1;
+    std::int64_t subBucket = static_cast<std::int64_t>(index & ((std::size_t(1) << subBucketBits) - 1)) + (std::int64_t(1) << subBucketBits);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::int64_t micros) {
+    micros = std::max<std::int64_t>(0, std::min(micros, maxTrackable));
+    buckets[bucketIndex(micros)]++;
+    totalCount++;
+    maxValue = std::max(maxValue, micros);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    totalCount += other.totalCount;
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+std::int64_t LatencyHistogram::percentile(double p) const {
+    if (totalCount == 0) {
+        return 0;
+    }
+
+    // Rank of the sample we are looking for, 1-based
+    std::uint64_t rank = static_cast<std::uint64_t>(p * totalCount + 0.5);
+    rank = std::max<std::uint64_t>(1, std::min(rank, totalCount));
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperValue(i), maxValue);
+        }
+    }
+    return maxValue;
+}
+
+LatencySummary LatencyHistogram::summary() const {
+    LatencySummary result;
+    result.count = totalCount;
+    result.p50 = percentile(0.50);
+    result.p90 = percentile(0.90);
+    result.p99 = percentile(0.99);
+    result.max = maxValue;
+    return result;
+}
+
+std::string formatLatencySummary(const LatencySummary& summary) {
+    return "p50 " + std::to_string(summary.p50) + "us, "
+        + "p90 " + std::to_string(summary.p90) + "us, "
+        + "p99 " + std::to_string(summary.p99) + "us, "
+        + "max " + std::to_string(summary.max) + "us (" + std::to_string(summary.count) + " events)";
+}
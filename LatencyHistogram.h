@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Summary of a latency distribution in microseconds, as stored with a session record
+struct LatencySummary {
+    std::uint64_t count = 0;
+    std::int64_t p50 = 0;
+    std::int64_t p90 = 0;
+    std::int64_t p99 = 0;
+    std::int64_t max = 0;
+};
+
+// HDR-style log-linear histogram of microsecond latencies.
+// Values below 64us are counted exactly; above that every power-of-two range is split into
+// 32 buckets, so any reported percentile is within ~3% of the true value. Recording is O(1)
+// and the memory footprint is fixed regardless of how many samples a session produces.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(std::int64_t micros);
+    void reset();
+
+    // Adds every sample of another histogram, e.g. to combine per-thread histograms
+    void merge(const LatencyHistogram& other);
+
+    std::uint64_t count() const { return totalCount; }
+    std::int64_t max() const { return maxValue; }
+
+    // Returns the highest value that falls in the same bucket as the p-th percentile sample
+    std::int64_t percentile(double p) const;
+
+    LatencySummary summary() const;
+
+private:
+    static constexpr int subBucketBits = 5;                        // 32 buckets per power of two
+    static constexpr std::int64_t maxTrackable = std::int64_t(1) << 26; // ~67 seconds
+    static constexpr std::size_t bucketCount = (26 - subBucketBits + 2) << subBucketBits;
+
+    static std::size_t bucketIndex(std::int64_t value);
+    static std::int64_t bucketUpperValue(std::size_t index);
+
+    std::array<std::uint64_t, bucketCount> buckets;
+    std::uint64_t totalCount = 0;
+    std::int64_t maxValue = 0;
+};
+
+// Function to format a summary as "p50 Xus, p90 Xus, p99 Xus, max Xus (N events)"
+std::string formatLatencySummary(const LatencySummary& summary);
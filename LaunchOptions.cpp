@@ -0,0 +1,92 @@
+#include "LaunchOptions.h"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    // Most particles --particles keeps alive; every one takes its slot in the pool for the whole run
+    const unsigned long maxStressParticles = 1000000;
+}
+
+LaunchOptions parseLaunchOptions(int argc, char** argv) {
+    LaunchOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--replay" && i + 1 < argc) {
+            options.replayFile = argv[++i];
+        }
+        else if (arg == "--player" && i + 1 < argc) {
+            options.playerName = argv[++i];
+        }
+        else if (arg == "--decks" && i + 1 < argc) {
+            options.deckPath = argv[++i];
+        }
+        else if (arg == "--assets" && i + 1 < argc) {
+            options.assetArchive = argv[++i];
+        }
+        else if (arg == "--stream" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long megabytes = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || megabytes == 0) {
+                std::cerr << "Ignoring invalid --stream size: " << argv[i] << "\n";
+            }
+            else {
+                options.streamMegabytes = megabytes;
+            }
+        }
+        else if (arg == "--frames" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long frames = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || frames == 0) {
+                std::cerr << "Ignoring invalid --frames count: " << argv[i] << "\n";
+            }
+            else {
+                options.headlessFrames = frames;
+            }
+        }
+        else if (arg == "--backend" && i + 1 < argc) {
+            std::string backend = argv[++i];
+            if (backend == "null" || backend == "texture") {
+                options.renderBackend = backend;
+            }
+            else {
+                std::cerr << "Ignoring unknown --backend: " << backend << " (expected null or texture)\n";
+            }
+        }
+        else if (arg == "--particles" && i + 1 < argc) {
+            char* end = nullptr;
+            unsigned long particles = std::strtoul(argv[++i], &end, 10);
+            if (*end != '\0') {
+                std::cerr << "Ignoring invalid --particles count: " << argv[i] << "\n";
+            }
+            else if (particles > maxStressParticles) {
+                std::cerr << "Clamping --particles " << argv[i] << " to " << maxStressParticles << "\n";
+                options.stressParticles = maxStressParticles;
+            }
+            else {
+                options.stressParticles = particles;
+            }
+        }
+        else if (arg == "--capture" && i + 1 < argc) {
+            options.captureDirectory = argv[++i];
+            options.headless = true;
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            options.deckFilter = argv[++i];
+        }
+        else if (arg == "--fast") {
+            options.fastReplay = true;
+        }
+        else if (arg == "--headless") {
+            options.headless = true;
+        }
+        else if (arg == "--shuffle") {
+            options.shuffleDeck = true;
+        }
+        else {
+            std::cerr << "Ignoring unknown argument: " << arg << "\n";
+        }
+    }
+
+    return options;
+}
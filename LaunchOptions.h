@@ -0,0 +1,23 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Command line switches understood by the game
+struct LaunchOptions {
+    std::string replayFile;  // --replay <file>: play a recorded round instead of taking input
+    bool fastReplay = false; // --fast: with --replay, run without a window as fast as possible
+    std::string playerName;  // --player <name>: schedule questions for this player instead of the last one
+    bool shuffleDeck = false; // --shuffle: ask every card once, in shuffled order, before repeating any
+    std::string deckFilter;   // --filter <tags>: only ask cards matching a tag filter, e.g. "Crypto AND NOT Wireless"
+    std::string deckPath = "acronyms.txt"; // --decks <path>: a deck file, or a directory of .txt decks to merge
+    std::string assetArchive = "assets.pak"; // --assets <file>: the packed textures, fonts and deck; loose files are used without it
+    std::size_t streamMegabytes = 0; // --stream <MB>: sample a deck file too large to load, keeping at most MB of it in memory
+    bool headless = false;    // --headless: play rounds with a typing bot and no window, then print frame-time statistics
+    std::size_t headlessFrames = 600; // --frames <N>: with --headless, how many frames to run
+    std::string renderBackend = "null"; // --backend null|texture: with --headless, count draw calls only or draw into an offscreen texture
+    std::size_t stressParticles = 0; // --particles <N>: with --headless, keep about N (at most a million) explosion particles alive to measure their cost
+    std::string captureDirectory; // --capture <dir>: run headless and save the title, gameplay and leaderboard frames there as PNGs
+};
+
+// Function to parse the process arguments (argv[0] is skipped)
+LaunchOptions parseLaunchOptions(int argc, char** argv);
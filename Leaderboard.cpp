@@ -0,0 +1,80 @@
+#include "Leaderboard.h"
+#include "Profiler.h"
+
+void buildHighScoreTexts(const sf::Font& font, const std::vector<std::pair<std::string, int>>& topScores, std::vector<sf::Text>& texts) {
+    texts.clear();
+
+    float yOffset = 155.0f; // Starting position for displaying the top 10 scores
+    for (size_t i = 0; i < topScores.size(); ++i) {
+        sf::Text playerName(std::to_string(i + 1) + ". " + topScores[i].first, font, 24);
+        playerName.setFillColor(sf::Color::White);
+        playerName.setPosition(60, yOffset);
+
+        sf::Text score(std::to_string(topScores[i].second), font, 24);
+        score.setFillColor(sf::Color::White);
+        score.setPosition(225, yOffset);
+
+        texts.push_back(playerName);
+        texts.push_back(score);
+
+        yOffset += 40.0f;
+    }
+}
+
+void addHighScorePanels(UiChrome& chrome) {
+    chrome.addRectangle(sf::FloatRect(50, 100, 350, 40), sf::Color(0, 0, 0, 150)); // Table header, semi-transparent black
+    chrome.addRectangle(sf::FloatRect(50, 150, 350, 400), sf::Color(0, 0, 0, 150)); // Table for the high scores
+}
+
+LeaderboardScene::LeaderboardScene(const sf::Font& font, bool uploadChrome)
+    : font(font) {
+    addHighScorePanels(chrome);
+    chrome.build(uploadChrome);
+
+    title = sf::Text("Top 10 High Scores", font, 30);
+    title.setFillColor(sf::Color::Yellow);
+    title.setPosition(85, 50);
+
+    // Title for the columns (Name and Score)
+    nameHeader = sf::Text("Name", font, 24);
+    nameHeader.setFillColor(sf::Color::White);
+    nameHeader.setPosition(85, 110); // Position of the column header
+
+    scoreHeader = sf::Text("Score", font, 24);
+    scoreHeader.setFillColor(sf::Color::White);
+    scoreHeader.setPosition(225, 110);
+
+    // Text for displaying final score
+    finalScoreText = sf::Text("", font, 24);
+    finalScoreText.setFillColor(sf::Color::White);
+    finalScoreText.setPosition(500, 300); // Position above the replay prompt
+
+    // Replay prompt display
+    replayText = sf::Text("Play again? (Y/N)", font, 24);
+    replayText.setFillColor(sf::Color::White);
+    replayText.setPosition(500, 340); // Position in the middle of the window, below the final score
+}
+
+void LeaderboardScene::draw(RenderBackend& backend, const std::vector<std::pair<std::string, int>>& topScores) {
+    backend.draw(chrome);
+
+    {
+        PROFILE_SCOPE("draw.highScores");
+        if (topScores != shownScores) {
+            shownScores = topScores;
+            buildHighScoreTexts(font, topScores, rows);
+        }
+
+        backend.draw(title);
+        backend.draw(nameHeader);
+        backend.draw(scoreHeader);
+
+        // Display the high scores in the table
+        for (const sf::Text& text : rows) {
+            backend.draw(text);
+        }
+    }
+
+    backend.draw(finalScoreText); // Draw the final score text
+    backend.draw(replayText); // Draw replay text
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "RenderBackend.h"
+#include "UiChrome.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Function to build the "rank. name" and score texts of the leaderboard, two per row
+void buildHighScoreTexts(const sf::Font& font, const std::vector<std::pair<std::string, int>>& topScores, std::vector<sf::Text>& texts);
+
+// Function to add the leaderboard's header and table panels to a screen's chrome
+void addHighScorePanels(UiChrome& chrome);
+
+// The leaderboard shown once the score is saved: the table over its panels and the replay prompt.
+// Its texts are made once, and the rows again only when the scores change, so drawing the same
+// table every frame allocates nothing.
+class LeaderboardScene {
+public:
+    explicit LeaderboardScene(const sf::Font& font, bool uploadChrome = true);
+
+    // Function to draw the leaderboard; the caller clears and displays the backend
+    void draw(RenderBackend& backend, const std::vector<std::pair<std::string, int>>& topScores);
+
+private:
+    const sf::Font& font;
+    UiChrome chrome;            // The table's panels, built once for every frame
+    sf::Text title;
+    sf::Text nameHeader;
+    sf::Text scoreHeader;
+    sf::Text finalScoreText;
+    sf::Text replayText;
+
+    // The table rows, for the scores they were built from
+    std::vector<std::pair<std::string, int>> shownScores;
+    std::vector<sf::Text> rows;
+};
@@ -0,0 +1,248 @@
+// Headless load generator.
+// Runs many bot-driven game sessions in parallel through the same selection, matching and
+// scoring code the game uses (GameSimulation) and writes the results through the score store,
+// to capacity-test the database and the deck index.
+//
+// Usage: "Load Generator.exe" [--sessions N] [--threads N] [--mode 0-3] [--cps N]
+//                             [--error-rate F] [--reaction-ms N] [--max-game-seconds N]
+//                             [--deck FILE|DIR] [--db FILE] [--no-db]
+#include "Acronyms.h"
+#include "DeckLibrary.h"
+#include "GameSimulation.h"
+#include "HighScores.h"
+#include "LatencyHistogram.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // How a simulated player behaves
+    struct BotProfile {
+        double charsPerSecond = 6.0;  // Typing speed
+        double errorRate = 0.1;       // Chance that an answer is mistyped
+        int reactionMillis = 700;     // Average time to read a question before typing
+    };
+
+    struct LoadOptions {
+        int sessions = 1000;
+        unsigned threads = std::thread::hardware_concurrency();
+        int gameMode = 0; // 0 cycles through all three modes
+        std::int64_t maxGameMillis = 10 * 60 * 1000; // A good bot earns time faster than it runs out, so cap each session
+        BotProfile bot;
+        std::string deckFile = "acronyms.txt";
+        std::string databaseFile = "loadtest.db";
+        bool writeScores = true;
+    };
+
+    // Totals over all sessions, guarded by a mutex and merged once per session
+    struct LoadTotals {
+        std::mutex mutex;
+        std::uint64_t answers = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t inserts = 0;
+        std::uint64_t reads = 0;
+        std::int64_t gameMillis = 0;
+        LatencyHistogram answerLatency; // Nanoseconds spent matching, scoring and selecting per answer
+        LatencyHistogram insertLatency; // Microseconds per insertScore call
+        LatencyHistogram readLatency;   // Microseconds per getTopScores call
+    };
+
+    std::int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Function to play one session with a bot until the round ends
+    void runBotSession(int sessionId, const LoadOptions& options, const AcronymMap& acronyms, const AcronymWeights& weights,
+        const std::vector<sf::Vector2f>& spaceshipSizes, LoadTotals& totals) {
+        int gameMode = options.gameMode != 0 ? options.gameMode : 1 + sessionId % 3;
+
+        // Every bot is a new player, so questions come from a fresh schedule like they would in the game
+        QuestionScheduler scheduler(acronyms, weights);
+        GameState game;
+        startGame(game, gameMode, acronyms, spaceshipSizes, sf::Vector2f(800, 600), static_cast<unsigned int>(sessionId), &scheduler);
+
+        std::mt19937 rng(static_cast<unsigned int>(sessionId) * 2654435761u);
+        std::normal_distribution<double> reaction(options.bot.reactionMillis, options.bot.reactionMillis * 0.25);
+        std::exponential_distribution<double> keyGap(options.bot.charsPerSecond / 1000.0);
+        std::uniform_real_distribution<double> chance(0.0, 1.0);
+        std::uniform_int_distribution<int> letter('A', 'Z');
+
+        LatencyHistogram answerLatency;
+        std::uint64_t hits = 0;
+
+        while (!game.gameOver && !game.quitRequested && game.elapsedMillis < options.maxGameMillis) {
+            advanceSimulation(game, std::max<std::int64_t>(50, static_cast<std::int64_t>(reaction(rng))));
+
+            std::string answer = (game.gameMode == 2) ? game.currentFullName : game.currentAcronym;
+            if (chance(rng) < options.bot.errorRate && !answer.empty()) {
+                answer[std::uniform_int_distribution<std::size_t>(0, answer.size() - 1)(rng)] = static_cast<char>(letter(rng));
+                answer += 'X'; // Make sure the typo is not another valid acronym
+            }
+
+            for (char c : answer) {
+                advanceSimulation(game, 1 + static_cast<std::int64_t>(keyGap(rng)));
+                handleTextEntered(game, acronyms, static_cast<sf::Uint32>(c));
+            }
+            advanceSimulation(game, 1 + static_cast<std::int64_t>(keyGap(rng)));
+            if (game.gameOver) {
+                break;
+            }
+
+            int scoreBefore = game.score;
+            std::int64_t start = nowNanos();
+            handleTextEntered(game, acronyms, 13);
+            answerLatency.record(nowNanos() - start);
+            if (game.score > scoreBefore) {
+                hits++;
+            }
+        }
+
+        std::int64_t insertMicros = 0;
+        std::int64_t readMicros = 0;
+        if (options.writeScores) {
+            std::int64_t start = nowNanos();
+            insertScore("Bot " + std::to_string(sessionId), game.score, LatencySummary());
+            insertMicros = (nowNanos() - start) / 1000;
+
+            // The game reads the leaderboard right after saving, so do the same
+            start = nowNanos();
+            getTopScores();
+            readMicros = (nowNanos() - start) / 1000;
+        }
+
+        std::lock_guard<std::mutex> lock(totals.mutex);
+        totals.answers += answerLatency.count();
+        totals.hits += hits;
+        totals.gameMillis += game.elapsedMillis;
+        totals.answerLatency.merge(answerLatency);
+        if (options.writeScores) {
+            totals.inserts++;
+            totals.reads++;
+            totals.insertLatency.record(insertMicros);
+            totals.readLatency.record(readMicros);
+        }
+    }
+
+    // Function to read the switches; std::stoi and friends throw on malformed numbers
+    void parseArguments(int argc, char** argv, LoadOptions& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--sessions" && hasValue) {
+                options.sessions = std::stoi(argv[++i]);
+            }
+            else if (arg == "--threads" && hasValue) {
+                options.threads = static_cast<unsigned>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--mode" && hasValue) {
+                options.gameMode = std::stoi(argv[++i]);
+            }
+            else if (arg == "--cps" && hasValue) {
+                options.bot.charsPerSecond = std::stod(argv[++i]);
+            }
+            else if (arg == "--error-rate" && hasValue) {
+                options.bot.errorRate = std::stod(argv[++i]);
+            }
+            else if (arg == "--reaction-ms" && hasValue) {
+                options.bot.reactionMillis = std::stoi(argv[++i]);
+            }
+            else if (arg == "--max-game-seconds" && hasValue) {
+                options.maxGameMillis = std::stoll(argv[++i]) * 1000;
+            }
+            else if (arg == "--deck" && hasValue) {
+                options.deckFile = argv[++i];
+            }
+            else if (arg == "--db" && hasValue) {
+                options.databaseFile = argv[++i];
+            }
+            else if (arg == "--no-db") {
+                options.writeScores = false;
+            }
+            else {
+                throw std::invalid_argument("unknown or incomplete argument " + arg);
+            }
+        }
+    }
+
+    // Function to parse the command line, returns false on a malformed argument
+    bool parseOptions(int argc, char** argv, LoadOptions& options) {
+        try {
+            parseArguments(argc, argv, options);
+        }
+        catch (const std::exception& error) {
+            std::cerr << "Invalid argument: " << error.what() << "\n";
+            return false;
+        }
+
+        if (options.gameMode < 0 || options.gameMode > 3 || options.sessions <= 0 || options.bot.charsPerSecond <= 0) {
+            std::cerr << "Invalid --mode, --sessions or --cps value\n";
+            return false;
+        }
+        return true;
+    }
+
+    std::string formatNanos(const LatencyHistogram& histogram) {
+        return "p50 " + std::to_string(histogram.percentile(0.50)) + "ns, "
+            + "p99 " + std::to_string(histogram.percentile(0.99)) + "ns, "
+            + "max " + std::to_string(histogram.max()) + "ns";
+    }
+}
+
+int main(int argc, char** argv) {
+    LoadOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    DeckLibrary library;
+    if (!loadDeckLibrary(options.deckFile, library) || library.acronyms.empty()) {
+        std::cerr << "Deck " << options.deckFile << " is empty\n";
+        return 1;
+    }
+    if (library.decks.size() > 1) {
+        printDeckLoadTimes(library, std::cout);
+    }
+    const AcronymMap& acronyms = library.acronyms;
+    const AcronymWeights& weights = library.weights;
+
+    std::vector<sf::Vector2f> spaceshipSizes;
+    if (!loadSpaceshipSizes(spaceshipSizes)) {
+        return 1;
+    }
+
+    if (options.writeScores) {
+        setDatabasePath(options.databaseFile);
+        initializeDatabase();
+    }
+
+    LoadTotals totals;
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingPool pool(options.threads);
+        std::cout << "Running " << options.sessions << " sessions on " << pool.size() << " threads\n";
+        for (int i = 0; i < options.sessions; ++i) {
+            pool.submit([i, &options, &acronyms, &weights, &spaceshipSizes, &totals]() {
+                runBotSession(i, options, acronyms, weights, spaceshipSizes, totals);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Sessions:        " << options.sessions << " in " << seconds << "s ("
+        << options.sessions / seconds << " sessions/s, " << totals.gameMillis / 1000.0 / seconds << "x real time)\n";
+    std::cout << "Answers:         " << totals.answers << " (" << totals.hits << " hits, " << totals.answers / seconds << " answers/s)\n";
+    std::cout << "Answer latency:  " << formatNanos(totals.answerLatency) << "\n";
+    if (options.writeScores) {
+        std::cout << "DB inserts:      " << totals.inserts << " (" << totals.inserts / seconds << " inserts/s), "
+            << formatLatencySummary(totals.insertLatency.summary()) << "\n";
+        std::cout << "DB reads:        " << totals.reads << " (" << totals.reads / seconds << " reads/s), "
+            << formatLatencySummary(totals.readLatency.summary()) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+// SSE2 is always there on x64 and is MSVC's default for x86; anything else takes the scalar loop
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_USE_SSE2
+#endif
+
+namespace {
+    const float gravity = 320.0f;     // Layout units per second squared, pulls the debris down
+    const float dragPerSecond = 1.4f; // Share of the speed lost per second
+    const float halfSize = 1.5f;      // Particles are 3x3 layout units
+
+    // Fire colors for the sparks, and grey for bits of the hull
+    const sf::Color palette[] = {
+        sf::Color(255, 244, 170), sf::Color(255, 196, 64), sf::Color(255, 128, 32),
+        sf::Color(224, 64, 24), sf::Color(150, 150, 160)
+    };
+}
+
+ParticleSystem::ParticleSystem(std::size_t capacity)
+    : maxParticles(capacity), vertices(sf::Quads, capacity * 4) {
+    std::size_t padded = (capacity + 3) & ~static_cast<std::size_t>(3);
+    for (std::vector<float>* field : { &positionX, &positionY, &velocityX, &velocityY, &life, &inverseLife }) {
+        field->assign(padded, 0.0f);
+    }
+    colors.assign(capacity, sf::Color::White);
+}
+
+void ParticleSystem::spawnExplosion(sf::Vector2f center, std::size_t count) {
+    count = std::min(count, maxParticles - live);
+    std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> speedDist(30.0f, 280.0f);
+    std::uniform_real_distribution<float> lifeDist(0.5f, 1.6f);
+    std::uniform_int_distribution<std::size_t> colorDist(0, std::size(palette) - 1);
+    for (std::size_t n = 0; n < count; ++n) {
+        std::size_t i = live++;
+        float angle = angleDist(rng);
+        float speed = speedDist(rng);
+        positionX[i] = center.x;
+        positionY[i] = center.y;
+        velocityX[i] = std::cos(angle) * speed;
+        velocityY[i] = std::sin(angle) * speed - 80.0f; // Thrown upwards a little before falling
+        life[i] = lifeDist(rng);
+        inverseLife[i] = 1.0f / life[i];
+        colors[i] = palette[colorDist(rng)];
+    }
+}
+
+void ParticleSystem::update(float seconds) {
+    float damping = std::max(0.0f, 1.0f - dragPerSecond * seconds);
+    float fall = gravity * seconds;
+    std::size_t padded = (live + 3) & ~static_cast<std::size_t>(3);
+
+#ifdef PARTICLES_USE_SSE2
+    // Four particles per step; the padding past the live ones is updated too, which is harmless.
+    // The arrays are only guaranteed 8-byte alignment on x86, hence the unaligned loads.
+    const __m128 step = _mm_set1_ps(seconds);
+    const __m128 drag = _mm_set1_ps(damping);
+    const __m128 pull = _mm_set1_ps(fall);
+    for (std::size_t i = 0; i < padded; i += 4) {
+        __m128 vx = _mm_mul_ps(_mm_loadu_ps(&velocityX[i]), drag);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&velocityY[i]), drag), pull);
+        _mm_storeu_ps(&velocityX[i], vx);
+        _mm_storeu_ps(&velocityY[i], vy);
+        _mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(vx, step)));
+        _mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(vy, step)));
+        _mm_storeu_ps(&life[i], _mm_sub_ps(_mm_loadu_ps(&life[i]), step));
+    }
+#else
+    for (std::size_t i = 0; i < padded; ++i) {
+        velocityX[i] *= damping;
+        velocityY[i] = velocityY[i] * damping + fall;
+        positionX[i] += velocityX[i] * seconds;
+        positionY[i] += velocityY[i] * seconds;
+        life[i] -= seconds;
+    }
+#endif
+
+    // Replace each dead particle with the last live one, keeping the live ones at the front
+    for (std::size_t i = 0; i < live;) {
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        --live;
+        positionX[i] = positionX[live];
+        positionY[i] = positionY[live];
+        velocityX[i] = velocityX[live];
+        velocityY[i] = velocityY[live];
+        life[i] = life[live];
+        inverseLife[i] = inverseLife[live];
+        colors[i] = colors[live];
+    }
+
+    // One quad per live particle, fading out over its life
+    for (std::size_t i = 0; i < live; ++i) {
+        sf::Color color = colors[i];
+        color.a = static_cast<sf::Uint8>(255.0f * std::min(1.0f, life[i] * inverseLife[i]));
+        float left = positionX[i] - halfSize;
+        float top = positionY[i] - halfSize;
+        float right = positionX[i] + halfSize;
+        float bottom = positionY[i] + halfSize;
+        sf::Vertex* quad = &vertices[i * 4];
+        quad[0].position = sf::Vector2f(left, top);
+        quad[1].position = sf::Vector2f(right, top);
+        quad[2].position = sf::Vector2f(right, bottom);
+        quad[3].position = sf::Vector2f(left, bottom);
+        quad[0].color = quad[1].color = quad[2].color = quad[3].color = color;
+    }
+}
+
+void ParticleSystem::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (live > 0) {
+        target.draw(&vertices[0], live * 4, sf::Quads, states);
+    }
+}
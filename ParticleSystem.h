@@ -0,0 +1,48 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Explosion sparks and debris, all drawn in one draw call.
+//
+// Every field of the particles has its own fixed array, sized once at construction, so the update
+// walks each field contiguously, four particles at a time with SSE2, and nothing is allocated while
+// the game runs. Dead particles are replaced by the last live one, so the live particles are always
+// the first liveCount(). Their quads are rewritten each update into one vertex array of the full
+// capacity, of which only the live part is drawn.
+class ParticleSystem : public sf::Drawable {
+public:
+    explicit ParticleSystem(std::size_t capacity = 100000);
+
+    // Function to burst count particles out from a point; any beyond the capacity are dropped
+    void spawnExplosion(sf::Vector2f center, std::size_t count);
+
+    // Function to advance the particles by the elapsed time and rewrite their quads
+    void update(float seconds);
+
+    // Function to remove every particle, e.g. when a round starts
+    void clear() { live = 0; }
+
+    std::size_t liveCount() const { return live; }
+    std::size_t capacity() const { return maxParticles; }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    std::size_t maxParticles;
+    std::size_t live = 0;
+
+    // Sized to the capacity rounded up to a multiple of four, so the update never needs a scalar tail
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;
+    std::vector<float> velocityY;
+    std::vector<float> life;        // Seconds left
+    std::vector<float> inverseLife; // 1 / the seconds it started with, to fade out
+    std::vector<sf::Color> colors;
+
+    sf::VertexArray vertices;
+    std::minstd_rand rng;
+};
@@ -0,0 +1,278 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+    const std::size_t ringCapacity = 1 << 17;                 // Events kept per thread (power of two)
+    const std::int64_t overlayWindowMicros = 2 * 1000000;     // The overlay summarises the last 2 seconds
+    const std::int64_t traceDumpWindowMicros = 10 * 1000000;  // F4 dumps the last 10 seconds
+
+    // One recorded scope; fields are atomics so the overlay can read while the owner writes
+    struct ProfileSlot {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::int64_t> startMicros{ 0 };
+        std::atomic<std::int64_t> durationMicros{ 0 };
+    };
+
+    struct ProfileRing {
+        explicit ProfileRing(std::uint32_t id) : slots(ringCapacity), threadId(id) {}
+
+        std::vector<ProfileSlot> slots;
+        std::atomic<std::uint64_t> written{ 0 }; // Total events ever written to this ring
+        std::atomic<bool> inUse{ true };         // Cleared when the owning thread exits
+        std::uint32_t threadId;
+        std::string threadName;                  // Guarded by the registry mutex
+    };
+
+    struct RecordedEvent {
+        const char* name;
+        std::int64_t startMicros;
+        std::int64_t durationMicros;
+        std::uint32_t threadId;
+    };
+
+    std::mutex& registryMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    // Rings are never freed; a ring whose thread has exited is handed to the next new thread
+    std::vector<std::unique_ptr<ProfileRing>>& ringRegistry() {
+        static std::vector<std::unique_ptr<ProfileRing>> rings;
+        return rings;
+    }
+
+    std::atomic<bool> overlayVisible{ false };
+
+    struct ThreadRingHolder {
+        ProfileRing* ring = nullptr;
+        ~ThreadRingHolder() {
+            if (ring) {
+                ring->inUse = false;
+            }
+        }
+    };
+
+    // Function to get (or claim) the ring buffer of the calling thread
+    ProfileRing& threadRing() {
+        thread_local ThreadRingHolder holder;
+        if (!holder.ring) {
+            std::lock_guard<std::mutex> lock(registryMutex());
+            auto& rings = ringRegistry();
+            for (auto& ring : rings) {
+                bool expected = false;
+                if (ring->inUse.compare_exchange_strong(expected, true)) {
+                    ring->written = 0; // Forget the events of the previous owner
+                    holder.ring = ring.get();
+                    break;
+                }
+            }
+            if (!holder.ring) {
+                rings.push_back(std::make_unique<ProfileRing>(static_cast<std::uint32_t>(rings.size() + 1)));
+                holder.ring = rings.back().get();
+            }
+            holder.ring->threadName = "Thread " + std::to_string(holder.ring->threadId);
+        }
+        return *holder.ring;
+    }
+
+    void recordEvent(const char* name, std::int64_t startMicros, std::int64_t durationMicros) {
+        ProfileRing& ring = threadRing();
+        std::uint64_t index = ring.written.load(std::memory_order_relaxed);
+        ProfileSlot& slot = ring.slots[index & (ringCapacity - 1)];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.startMicros.store(startMicros, std::memory_order_relaxed);
+        slot.durationMicros.store(durationMicros, std::memory_order_relaxed);
+        ring.written.store(index + 1, std::memory_order_release);
+    }
+
+    // Function to copy every event that started at or after sinceMicros out of all rings
+    std::vector<RecordedEvent> collectEvents(std::int64_t sinceMicros) {
+        std::vector<RecordedEvent> events;
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (auto& ring : ringRegistry()) {
+            std::uint64_t end = ring->written.load(std::memory_order_acquire);
+            std::uint64_t begin = end > ringCapacity ? end - ringCapacity : 0;
+
+            std::size_t firstCopied = events.size();
+            std::vector<std::uint64_t> indices;
+            for (std::uint64_t i = begin; i < end; ++i) {
+                const ProfileSlot& slot = ring->slots[i & (ringCapacity - 1)];
+                RecordedEvent event{ slot.name.load(std::memory_order_relaxed),
+                    slot.startMicros.load(std::memory_order_relaxed),
+                    slot.durationMicros.load(std::memory_order_relaxed),
+                    ring->threadId };
+                if (event.name && event.startMicros >= sinceMicros) {
+                    events.push_back(event);
+                    indices.push_back(i);
+                }
+            }
+
+            // Drop anything the owner may have overwritten while we were copying
+            std::uint64_t after = ring->written.load(std::memory_order_acquire);
+            if (after >= ringCapacity) {
+                std::uint64_t oldestSafe = after - ringCapacity + 1;
+                std::size_t keep = firstCopied;
+                for (std::size_t i = 0; i < indices.size(); ++i) {
+                    if (indices[i] >= oldestSafe) {
+                        events[keep++] = events[firstCopied + i];
+                    }
+                }
+                events.resize(keep);
+            }
+        }
+        return events;
+    }
+
+    // Function to read a percentile from sorted samples
+    std::int64_t percentile(const std::vector<std::int64_t>& sorted, double p) {
+        std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+ProfileScope::ProfileScope(const char* name) : name(name), startMicros(profilerMicros()) {
+}
+
+ProfileScope::~ProfileScope() {
+    recordEvent(name, startMicros, profilerMicros() - startMicros);
+}
+
+std::int64_t profilerMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void setProfilerThreadName(const std::string& name) {
+    ProfileRing& ring = threadRing();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    ring.threadName = name;
+}
+
+std::vector<PhaseStats> collectPhaseStats(std::int64_t windowMicros) {
+    std::map<std::string, std::vector<std::int64_t>> durations;
+    for (const RecordedEvent& event : collectEvents(profilerMicros() - windowMicros)) {
+        durations[event.name].push_back(event.durationMicros);
+    }
+
+    std::vector<PhaseStats> stats;
+    for (auto& entry : durations) {
+        std::vector<std::int64_t>& samples = entry.second;
+        std::sort(samples.begin(), samples.end());
+
+        PhaseStats phase;
+        phase.name = entry.first;
+        phase.count = samples.size();
+        phase.p50 = percentile(samples, 0.50);
+        phase.p99 = percentile(samples, 0.99);
+        phase.max = samples.back();
+        stats.push_back(phase);
+    }
+    return stats;
+}
+
+bool writeChromeTrace(const std::string& filename, std::int64_t windowMicros) {
+    std::vector<RecordedEvent> events = collectEvents(profilerMicros() - windowMicros);
+
+    std::ofstream file(filename);
+    if (!file) {
+        std::cerr << "Error: Unable to write trace file: " << filename << std::endl;
+        return false;
+    }
+
+    std::int64_t origin = events.empty() ? 0 : events.front().startMicros;
+    for (const RecordedEvent& event : events) {
+        origin = std::min(origin, event.startMicros);
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        // Thread names, so Perfetto shows "Render" instead of a bare id
+        std::lock_guard<std::mutex> lock(registryMutex());
+        for (auto& ring : ringRegistry()) {
+            file << (first ? "" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId
+                << ",\"args\":{\"name\":\"" << ring->threadName << "\"}}";
+            first = false;
+        }
+    }
+    for (const RecordedEvent& event : events) {
+        file << (first ? "" : ",\n")
+            << "{\"name\":\"" << event.name << "\",\"cat\":\"frame\",\"ph\":\"X\""
+            << ",\"ts\":" << (event.startMicros - origin)
+            << ",\"dur\":" << event.durationMicros
+            << ",\"pid\":1,\"tid\":" << event.threadId << "}";
+        first = false;
+    }
+    file << "\n]}\n";
+
+    std::cout << "Wrote " << events.size() << " profiler events to " << filename << std::endl;
+    return true;
+}
+
+bool handleProfilerHotkeys(const sf::Event& event) {
+    if (event.type != sf::Event::KeyPressed) {
+        return false;
+    }
+
+    if (event.key.code == sf::Keyboard::F3) {
+        overlayVisible = !overlayVisible;
+        return true;
+    }
+    if (event.key.code == sf::Keyboard::F4) {
+        writeChromeTrace("trace_" + std::to_string(std::time(nullptr)) + ".json", traceDumpWindowMicros);
+        return true;
+    }
+    return false;
+}
+
+bool isProfilerOverlayVisible() {
+    return overlayVisible;
+}
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font) : text("", font, 14) {
+    text.setFillColor(sf::Color::White);
+    text.setPosition(50, 45); // Below the timer
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+}
+
+void ProfilerOverlay::setFooterSource(std::function<std::string()> source) {
+    footerSource = std::move(source);
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target) {
+    if (!overlayVisible) {
+        hasText = false;
+        return;
+    }
+
+    // Rebuilding the table sorts a few thousand samples, so only do it four times a second
+    if (!hasText || refreshClock.getElapsedTime().asSeconds() >= 0.25f) {
+        std::string table = "Phase (us, last 2s)    p50 / p99 / max\n";
+        for (const PhaseStats& phase : collectPhaseStats(overlayWindowMicros)) {
+            table += phase.name + ":  " + std::to_string(phase.p50) + " / " + std::to_string(phase.p99)
+                + " / " + std::to_string(phase.max) + "\n";
+        }
+        if (footerSource) {
+            table += footerSource() + "\n";
+        }
+        text.setString(table);
+
+        sf::FloatRect bounds = text.getGlobalBounds();
+        background.setPosition(bounds.left - 6, bounds.top - 6);
+        background.setSize(sf::Vector2f(bounds.width + 12, bounds.height + 12));
+
+        refreshClock.restart();
+        hasText = true;
+    }
+
+    target.draw(background);
+    target.draw(text);
+}
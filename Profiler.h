@@ -0,0 +1,76 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Lightweight frame profiler.
+// Each thread records scoped timings into its own fixed-size ring buffer, so recording never
+// locks or allocates. The rings can be summarised for the F3 overlay or dumped as Chrome
+// trace_event JSON (F4), which opens in Perfetto or chrome://tracing.
+
+// Rolling statistics for one named phase, in microseconds
+struct PhaseStats {
+    std::string name;
+    std::size_t count = 0;
+    std::int64_t p50 = 0;
+    std::int64_t p99 = 0;
+    std::int64_t max = 0;
+};
+
+// Records the time between construction and destruction under a static name
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    std::int64_t startMicros;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+// Function to read the profiler clock
+std::int64_t profilerMicros();
+
+// Function to label the calling thread in traces (e.g. "Render")
+void setProfilerThreadName(const std::string& name);
+
+// Function to compute p50/p99/max per phase over the last windowMicros of recorded events
+std::vector<PhaseStats> collectPhaseStats(std::int64_t windowMicros);
+
+// Function to write the last windowMicros of events as Chrome trace_event JSON
+bool writeChromeTrace(const std::string& filename, std::int64_t windowMicros);
+
+// Function to handle the profiler hotkeys: F3 toggles the overlay, F4 dumps a trace file.
+// Returns true if the event was consumed.
+bool handleProfilerHotkeys(const sf::Event& event);
+
+// Function to check whether the F3 overlay is switched on
+bool isProfilerOverlayVisible();
+
+// On-screen table of the rolling phase statistics
+class ProfilerOverlay {
+public:
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    // Draws the overlay if it is switched on; the statistics are refreshed a few times per second
+    void draw(sf::RenderTarget& target);
+
+    // Extra lines shown under the phase table, queried on each refresh
+    void setFooterSource(std::function<std::string()> source);
+
+private:
+    std::function<std::string()> footerSource;
+    sf::RectangleShape background;
+    sf::Text text;
+    sf::Clock refreshClock;
+    bool hasText = false;
+};
@@ -0,0 +1,287 @@
+#include "QuestionScheduler.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    // First intervals after a hit, then each interval grows by the card's ease
+    const std::uint32_t firstInterval = 3;
+    const std::uint32_t secondInterval = 8;
+    const std::uint32_t maxInterval = 1u << 30;
+
+    // A missed card comes back after one other question
+    const std::uint32_t lapseInterval = 2;
+
+    const std::uint16_t minEase = 130;
+    const std::uint16_t maxEase = 400;
+    const std::uint16_t easeStep = 10;   // Hit: SM-2 quality 5 adds 0.1
+    const std::uint16_t lapsePenalty = 20; // Miss: take 0.2 off
+
+    // Weighted draws retry this often before settling for something else
+    const int maxDrawAttempts = 16;
+
+    // Function to weigh an answered card for reviewing ahead: low ease (many misses) and a recent
+    // miss both make it come up more
+    float historyWeight(const CardSchedule& schedule) {
+        float weight = 250.0f / schedule.ease;
+        return schedule.repetitions == 0 ? weight * 2.0f : weight;
+    }
+}
+
+QuestionScheduler::QuestionScheduler(const AcronymMap& acronyms, const AcronymWeights& weights) {
+    entries.reserve(acronyms.size());
+    deckWeights.reserve(acronyms.size());
+    for (const auto& entry : acronyms) {
+        entries.push_back(&entry);
+
+        auto weight = weights.find(entry.first);
+        deckWeights.push_back(weight != weights.end() ? weight->second : 1.0f);
+        weightedDeck = weightedDeck || deckWeights.back() != 1.0f;
+    }
+    restore(0, std::vector<StoredCard>());
+}
+
+void QuestionScheduler::restore(std::uint32_t reviewStep, const std::vector<StoredCard>& stored) {
+    std::size_t count = entries.size();
+    cards.assign(count, CardSchedule());
+    inHeap.assign(count, 0);
+    slot.assign(count, 0);
+    heap.clear();
+    newCardTree.assign(count + 1, 0);
+    newCardCount = 0;
+    reviewLog.clear();
+    lastAnswered = noCard;
+    step = reviewStep;
+
+    if (!stored.empty()) {
+        std::unordered_map<std::string, std::uint32_t> cardByAcronym;
+        cardByAcronym.reserve(count);
+        for (std::uint32_t card = 0; card < count; ++card) {
+            cardByAcronym.emplace(entries[card]->first, card);
+        }
+        for (const StoredCard& storedCard : stored) {
+            auto it = cardByAcronym.find(storedCard.acronym);
+            if (it != cardByAcronym.end() && storedCard.schedule.interval > 0) {
+                cards[it->second] = storedCard.schedule;
+                inHeap[it->second] = 1;
+            }
+        }
+    }
+
+    for (std::uint32_t card = 0; card < count; ++card) {
+        if (inHeap[card]) {
+            slot[card] = static_cast<std::uint32_t>(heap.size());
+            heap.push_back(card);
+        }
+        else {
+            newCardTree[card + 1] = 1;
+            newCardCount++;
+        }
+    }
+    for (std::size_t i = heap.size() / 2; i-- > 0;) {
+        siftDown(i);
+    }
+
+    // Linear-time Fenwick build: push each node's count into its parent
+    for (std::size_t i = 1; i <= count; ++i) {
+        std::size_t parent = i + (i & (~i + 1));
+        if (parent <= count) {
+            newCardTree[parent] += newCardTree[i];
+        }
+    }
+
+    // Answered cards stay answered, so the review-ahead table can never return a new card
+    std::vector<float> weights(count, 0.0f);
+    for (std::uint32_t card = 0; card < count; ++card) {
+        if (inHeap[card]) {
+            weights[card] = deckWeights[card] * historyWeight(cards[card]);
+        }
+    }
+    reviewAheadTable.build(weights);
+
+    if (weightedDeck) {
+        for (std::uint32_t card = 0; card < count; ++card) {
+            weights[card] = inHeap[card] ? 0.0f : deckWeights[card];
+        }
+        newCardTable.build(weights);
+    }
+    else {
+        newCardTable.build(std::vector<float>());
+    }
+}
+
+std::uint32_t QuestionScheduler::pickNext(std::mt19937& rng) const {
+    if (!heap.empty() && cards[heap[0]].due <= step) {
+        return heap[0];
+    }
+    if (newCardCount > 0) {
+        return pickNewCard(rng);
+    }
+    return pickReviewAhead(rng);
+}
+
+std::uint32_t QuestionScheduler::pickNewCard(std::mt19937& rng) const {
+    // Rejection keeps the draw proportional to the weights of the cards that are still new
+    if (!newCardTable.empty()) {
+        for (int attempt = 0; attempt < maxDrawAttempts; ++attempt) {
+            std::uint32_t card = newCardTable.draw(rng);
+            if (!inHeap[card]) {
+                return card;
+            }
+        }
+    }
+
+    // Unweighted deck, or most of the weight has been introduced already
+    std::uniform_int_distribution<std::uint32_t> newDist(0, newCardCount - 1);
+    return findNewCard(newDist(rng));
+}
+
+std::uint32_t QuestionScheduler::pickReviewAhead(std::mt19937& rng) const {
+    if (!reviewAheadTable.empty()) {
+        for (int attempt = 0; attempt < maxDrawAttempts; ++attempt) {
+            std::uint32_t card = reviewAheadTable.draw(rng);
+            if (card != lastAnswered) {
+                return card;
+            }
+        }
+    }
+    return heap.empty() ? noCard : heap[0]; // Ask the card due soonest
+}
+
+void QuestionScheduler::answer(std::uint32_t card, bool correct) {
+    CardSchedule& schedule = cards[card];
+
+    if (correct) {
+        schedule.repetitions++;
+        if (schedule.repetitions == 1) {
+            schedule.interval = firstInterval;
+        }
+        else if (schedule.repetitions == 2) {
+            schedule.interval = secondInterval;
+        }
+        else {
+            std::uint64_t grown = (static_cast<std::uint64_t>(schedule.interval) * schedule.ease + 99) / 100;
+            schedule.interval = static_cast<std::uint32_t>(std::min<std::uint64_t>(grown, maxInterval));
+        }
+        schedule.ease = std::min<std::uint16_t>(maxEase, schedule.ease + easeStep);
+    }
+    else {
+        schedule.repetitions = 0;
+        schedule.interval = lapseInterval;
+        schedule.ease = std::max<std::uint16_t>(minEase, schedule.ease - lapsePenalty);
+    }
+    schedule.due = step + schedule.interval;
+    step++;
+
+    if (inHeap[card]) {
+        // A card answered before it was due can move either way
+        siftUp(slot[card]);
+        siftDown(slot[card]);
+    }
+    else {
+        takeFromNewCards(card);
+        inHeap[card] = 1;
+        heap.push_back(card);
+        siftUp(heap.size() - 1);
+    }
+
+    reviewLog.push_back({ card, correct });
+    lastAnswered = card;
+}
+
+std::vector<StoredCard> QuestionScheduler::answeredCards() const {
+    std::vector<StoredCard> result;
+    result.reserve(heap.size());
+    for (std::uint32_t card = 0; card < entries.size(); ++card) {
+        if (inHeap[card]) {
+            result.push_back({ entries[card]->first, cards[card] });
+        }
+    }
+    return result;
+}
+
+std::vector<StoredCard> QuestionScheduler::changedCards() const {
+    // A card answered several times is listed once
+    std::vector<std::uint32_t> answered;
+    answered.reserve(reviewLog.size());
+    for (const Review& review : reviewLog) {
+        answered.push_back(review.card);
+    }
+    std::sort(answered.begin(), answered.end());
+    answered.erase(std::unique(answered.begin(), answered.end()), answered.end());
+
+    std::vector<StoredCard> result;
+    result.reserve(answered.size());
+    for (std::uint32_t card : answered) {
+        result.push_back({ entries[card]->first, cards[card] });
+    }
+    return result;
+}
+
+bool QuestionScheduler::isEarlier(std::uint32_t a, std::uint32_t b) const {
+    // Ties are broken by card index so the earliest card does not depend on the heap layout
+    if (cards[a].due != cards[b].due) {
+        return cards[a].due < cards[b].due;
+    }
+    return a < b;
+}
+
+void QuestionScheduler::placeInHeap(std::size_t index, std::uint32_t card) {
+    heap[index] = card;
+    slot[card] = static_cast<std::uint32_t>(index);
+}
+
+void QuestionScheduler::siftUp(std::size_t index) {
+    std::uint32_t card = heap[index];
+    while (index > 0) {
+        std::size_t parent = (index - 1) / 2;
+        if (!isEarlier(card, heap[parent])) {
+            break;
+        }
+        placeInHeap(index, heap[parent]);
+        index = parent;
+    }
+    placeInHeap(index, card);
+}
+
+void QuestionScheduler::siftDown(std::size_t index) {
+    std::uint32_t card = heap[index];
+    std::size_t size = heap.size();
+    while (true) {
+        std::size_t child = 2 * index + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && isEarlier(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!isEarlier(heap[child], card)) {
+            break;
+        }
+        placeInHeap(index, heap[child]);
+        index = child;
+    }
+    placeInHeap(index, card);
+}
+
+void QuestionScheduler::takeFromNewCards(std::uint32_t card) {
+    for (std::size_t i = card + 1; i < newCardTree.size(); i += i & (~i + 1)) {
+        newCardTree[i]--;
+    }
+    newCardCount--;
+}
+
+std::uint32_t QuestionScheduler::findNewCard(std::uint32_t rank) const {
+    // Descend the tree from the highest power of two, skipping blocks with rank or fewer new cards
+    std::size_t position = 0;
+    std::size_t step = 1;
+    while (step * 2 < newCardTree.size()) {
+        step *= 2;
+    }
+    for (; step > 0; step /= 2) {
+        if (position + step < newCardTree.size() && newCardTree[position + step] <= rank) {
+            position += step;
+            rank -= newCardTree[position];
+        }
+    }
+    return static_cast<std::uint32_t>(position); // The card sits at tree index position + 1
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "Acronyms.h"
+#include "AliasTable.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Spaced-repetition state of one card (SM-2 style).
+// Time is counted in reviews: every answered question advances the player's review step by one,
+// so "due" and "interval" mean "after this many more questions" both within a round and across
+// sessions.
+struct CardSchedule {
+    std::uint32_t due = 0;         // Review step at which the card should be asked again
+    std::uint32_t interval = 0;    // Reviews between the last answer and due, 0 = never answered
+    std::uint16_t ease = 250;      // Interval growth factor in hundredths, SM-2 starts at 2.5
+    std::uint16_t repetitions = 0; // Hits in a row since the last miss
+};
+
+// A card's schedule keyed by its acronym, as stored in the score database and in replays
+struct StoredCard {
+    std::string acronym;
+    CardSchedule schedule;
+};
+
+// Picks the next question by due time instead of uniformly at random.
+//
+// Cards that were answered before sit in an indexed binary min-heap ordered by (due, card), with
+// each card's heap slot tracked so a card can be re-keyed in place. Cards that were never answered
+// are introduced in random order whenever no answered card is due; they are counted in a Fenwick
+// tree over the deck order, so the k-th one can be found and removed in O(log n).
+// Picking and answering are both O(log n), so the per-question cost stays flat for decks of
+// millions of cards; only building and restoring the scheduler is linear in the deck size.
+//
+// When nothing is due, the choice is weighted. New cards are drawn by their deck weight from an
+// alias table (rejecting cards answered since the table was built). Once every card has been
+// introduced, the player reviews ahead, drawing answered cards by deck weight times how badly
+// they went so far. Both tables are built by restore(), i.e. once per round, which keeps draws O(1).
+//
+// Which card is picked only depends on the card states and the review step, never on the order
+// of earlier calls, so a round restored from answeredCards() plays out exactly like the original.
+class QuestionScheduler {
+public:
+    static constexpr std::uint32_t noCard = 0xFFFFFFFF;
+
+    // A single answer, kept so a round can be re-applied to another player's schedule
+    struct Review {
+        std::uint32_t card;
+        bool correct;
+    };
+
+    // Function to build a scheduler with every card of the deck unanswered; the deck must outlive it
+    explicit QuestionScheduler(const AcronymMap& acronyms, const AcronymWeights& weights = AcronymWeights());
+
+    // Function to replace the state with a saved one; unknown acronyms are skipped
+    void restore(std::uint32_t reviewStep, const std::vector<StoredCard>& cards);
+
+    // Function to pick the card to ask next, noCard if the deck is empty
+    std::uint32_t pickNext(std::mt19937& rng) const;
+
+    // Function to reschedule a card after the player hit or missed it
+    void answer(std::uint32_t card, bool correct);
+
+    const std::string& acronym(std::uint32_t card) const { return entries[card]->first; }
+    const std::string& fullName(std::uint32_t card) const { return entries[card]->second; }
+
+    std::uint32_t reviewStep() const { return step; }
+    std::size_t size() const { return entries.size(); }
+    const std::vector<Review>& reviews() const { return reviewLog; }
+
+    // Function to list every card that has been answered, e.g. for a replay header
+    std::vector<StoredCard> answeredCards() const;
+
+    // Function to list the cards answered since the scheduler was built or restored
+    std::vector<StoredCard> changedCards() const;
+
+private:
+    bool isEarlier(std::uint32_t a, std::uint32_t b) const;
+    void placeInHeap(std::size_t index, std::uint32_t card);
+    void siftUp(std::size_t index);
+    void siftDown(std::size_t index);
+    void takeFromNewCards(std::uint32_t card);
+    std::uint32_t findNewCard(std::uint32_t rank) const;
+    std::uint32_t pickNewCard(std::mt19937& rng) const;
+    std::uint32_t pickReviewAhead(std::mt19937& rng) const;
+
+    std::vector<const AcronymMap::value_type*> entries; // Card -> deck entry, in deck iteration order
+    std::vector<CardSchedule> cards;
+    std::vector<float> deckWeights;
+    bool weightedDeck = false;       // Some card has a weight other than 1
+    AliasTable newCardTable;         // Deck weights, only built for weighted decks
+    AliasTable reviewAheadTable;     // Deck weight times history, cards answered at restore() only
+    std::uint32_t lastAnswered = noCard;
+    std::vector<std::uint32_t> heap;         // Answered cards, earliest (due, card) first
+    std::vector<std::uint32_t> slot;         // Position of each answered card in heap
+    std::vector<std::uint32_t> newCardTree;  // Fenwick tree counting never answered cards, 1-based
+    std::uint32_t newCardCount = 0;
+    std::vector<char> inHeap;
+    std::vector<Review> reviewLog;
+    std::uint32_t step = 0;
+};
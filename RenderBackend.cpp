@@ -0,0 +1,50 @@
+#include "RenderBackend.h"
+#include "AllocationCounter.h"
+
+void RenderBackend::clear(sf::Color color) {
+    if (sf::RenderTarget* drawTarget = target()) {
+        drawTarget->clear(color);
+    }
+}
+
+void RenderBackend::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+    draws++;
+    if (sf::RenderTarget* drawTarget = target()) {
+        drawTarget->draw(drawable, states);
+    }
+}
+
+void RenderBackend::draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type, const sf::RenderStates& states) {
+    draws++;
+    if (sf::RenderTarget* drawTarget = target()) {
+        drawTarget->draw(vertices, vertexCount, type, states);
+    }
+}
+
+const sf::View& RenderBackend::getView() {
+    sf::RenderTarget* drawTarget = target();
+    return drawTarget ? drawTarget->getView() : nullView;
+}
+
+void RenderBackend::setView(const sf::View& view) {
+    if (sf::RenderTarget* drawTarget = target()) {
+        drawTarget->setView(view);
+    }
+    else {
+        nullView = view;
+    }
+}
+
+void RenderBackend::display() {
+    present();
+    lastFrameDraws = draws;
+    draws = 0;
+
+    std::uint64_t allocations = threadAllocationCount();
+    lastFrameAllocations = allocations - frameStartAllocations;
+    frameStartAllocations = allocations;
+}
+
+bool TextureBackend::create(unsigned width, unsigned height) {
+    return texture.create(width, height);
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Where a frame is drawn: the game window, an offscreen texture, or nowhere.
+//
+// Screens draw through a backend instead of straight to the window, so the same frame code runs
+// with a window, headless into an sf::RenderTexture (which only needs a GL context, e.g. Mesa's
+// software renderer), or with no GL at all. Every draw is counted either way, so the draw calls of
+// a frame can be reported without a GPU, and in debug builds so can the heap allocations made
+// while drawing it.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    // The target the frame is drawn to, nullptr for the null backend. Code that needs GL
+    // resources of its own (render textures, vertex buffers) checks this first.
+    virtual sf::RenderTarget* target() = 0;
+
+    // Size of the target in pixels
+    virtual sf::Vector2u size() const = 0;
+
+    // Function to start a frame
+    void clear(sf::Color color = sf::Color::Black);
+
+    // Functions to draw, counting the call; the null backend only counts
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t vertexCount, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Functions to get and set the view, kept by the backend when there is no target
+    const sf::View& getView();
+    void setView(const sf::View& view);
+
+    // Function to finish the frame, e.g. swap the window's buffers
+    void display();
+
+    // Draw calls of the last finished frame
+    std::size_t frameDrawCalls() const { return lastFrameDraws; }
+
+    // Heap allocations the drawing thread made between the last two display() calls; always 0
+    // unless allocations are counted (AllocationCounter.h)
+    std::uint64_t frameAllocations() const { return lastFrameAllocations; }
+
+protected:
+    virtual void present() = 0;
+
+private:
+    sf::View nullView;
+    std::size_t draws = 0;
+    std::size_t lastFrameDraws = 0;
+    std::uint64_t frameStartAllocations = 0;
+    std::uint64_t lastFrameAllocations = 0;
+};
+
+// Draws to the game window
+class WindowBackend : public RenderBackend {
+public:
+    explicit WindowBackend(sf::RenderWindow& window) : window(window) {}
+
+    sf::RenderTarget* target() override { return &window; }
+    sf::Vector2u size() const override { return window.getSize(); }
+
+protected:
+    void present() override { window.display(); }
+
+private:
+    sf::RenderWindow& window;
+};
+
+// Draws to an offscreen texture, for headless runs that still exercise GL
+class TextureBackend : public RenderBackend {
+public:
+    // Function to create the texture, returns false without a usable GL context
+    bool create(unsigned width, unsigned height);
+
+    sf::RenderTarget* target() override { return &texture; }
+    sf::Vector2u size() const override { return texture.getSize(); }
+
+    const sf::Texture& result() const { return texture.getTexture(); }
+
+protected:
+    void present() override { texture.display(); }
+
+private:
+    sf::RenderTexture texture;
+};
+
+// Draws nothing, only counts, and never touches GL
+class NullBackend : public RenderBackend {
+public:
+    explicit NullBackend(sf::Vector2u size) : targetSize(size) {}
+
+    sf::RenderTarget* target() override { return nullptr; }
+    sf::Vector2u size() const override { return targetSize; }
+
+protected:
+    void present() override {}
+
+private:
+    sf::Vector2u targetSize;
+};
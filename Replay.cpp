@@ -0,0 +1,241 @@
+#include "Replay.h"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    const char replayMagic[4] = { 'A', 'I', 'R', 'P' };
+    const std::uint8_t replayVersion = 4;
+    const std::uint8_t spacedRepetitionFlag = 1;
+    const std::uint8_t shuffledFlag = 2;
+    const std::uint8_t deckFilterFlag = 4;
+    const std::uint8_t streamedFlag = 8;
+
+    void writeVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    bool readVarint(const std::vector<std::uint8_t>& bytes, std::size_t& offset, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset >= bytes.size()) {
+                return false;
+            }
+            std::uint8_t byte = bytes[offset++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Function to read a length-prefixed string
+    bool readString(const std::vector<std::uint8_t>& bytes, std::size_t& offset, std::string& text) {
+        std::uint64_t length = 0;
+        if (!readVarint(bytes, offset, length) || length > bytes.size() - offset) {
+            return false;
+        }
+        text.assign(bytes.begin() + offset, bytes.begin() + offset + static_cast<std::size_t>(length));
+        offset += static_cast<std::size_t>(length);
+        return true;
+    }
+
+    // Function to read the flags byte and, if present, the scheduler state, deck filter and stream
+    // budget of a version 2 or later header
+    bool readRoundOptions(const std::vector<std::uint8_t>& bytes, std::size_t& offset, ReplayHeader& header) {
+        if (offset >= bytes.size()) {
+            return false;
+        }
+        std::uint8_t flags = bytes[offset++];
+        header.spacedRepetition = (flags & spacedRepetitionFlag) != 0;
+        header.shuffled = (flags & shuffledFlag) != 0;
+        if (header.spacedRepetition) {
+            std::uint64_t reviewStep = 0;
+            std::uint64_t count = 0;
+            if (!readVarint(bytes, offset, reviewStep) || !readVarint(bytes, offset, count)) {
+                return false;
+            }
+            header.reviewStep = static_cast<std::uint32_t>(reviewStep);
+
+            for (std::uint64_t i = 0; i < count; ++i) {
+                StoredCard card;
+                std::uint64_t due = 0, interval = 0, ease = 0, repetitions = 0;
+                if (!readString(bytes, offset, card.acronym) || !readVarint(bytes, offset, due) || !readVarint(bytes, offset, interval)
+                    || !readVarint(bytes, offset, ease) || !readVarint(bytes, offset, repetitions)) {
+                    return false;
+                }
+                card.schedule.due = static_cast<std::uint32_t>(due);
+                card.schedule.interval = static_cast<std::uint32_t>(interval);
+                card.schedule.ease = static_cast<std::uint16_t>(ease);
+                card.schedule.repetitions = static_cast<std::uint16_t>(repetitions);
+                header.schedule.push_back(card);
+            }
+        }
+
+        if ((flags & deckFilterFlag) != 0 && !readString(bytes, offset, header.deckFilter)) {
+            return false;
+        }
+        if ((flags & streamedFlag) != 0 && !readVarint(bytes, offset, header.streamBudget)) {
+            return false;
+        }
+        return true;
+    }
+}
+
+std::uint64_t hashDeck(const AcronymMap& acronyms, const AcronymWeights& weights) {
+    // FNV-1a over every entry in iteration order
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const std::string& text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xFF; // Separator so "AB","C" and "A","BC" differ
+        hash *= 1099511628211ull;
+    };
+    for (const auto& entry : acronyms) {
+        mix(entry.first);
+        mix(entry.second);
+
+        // Only explicit weights are mixed in, so decks without a weight column keep their old hash
+        auto weight = weights.find(entry.first);
+        if (weight != weights.end()) {
+            mix(std::to_string(weight->second));
+        }
+    }
+    return hash;
+}
+
+void ReplayRecorder::begin(const ReplayHeader& header) {
+    bytes.assign(std::begin(replayMagic), std::end(replayMagic));
+    bytes.push_back(replayVersion);
+    writeVarint(bytes, header.seed);
+    writeVarint(bytes, static_cast<std::uint64_t>(header.gameMode));
+    for (int i = 0; i < 8; ++i) {
+        bytes.push_back(static_cast<std::uint8_t>(header.deckHash >> (8 * i)));
+    }
+
+    bytes.push_back((header.spacedRepetition ? spacedRepetitionFlag : 0) | (header.shuffled ? shuffledFlag : 0)
+        | (header.deckFilter.empty() ? 0 : deckFilterFlag) | (header.streamBudget == 0 ? 0 : streamedFlag));
+    if (header.spacedRepetition) {
+        writeVarint(bytes, header.reviewStep);
+        writeVarint(bytes, header.schedule.size());
+        for (const StoredCard& card : header.schedule) {
+            writeVarint(bytes, card.acronym.size());
+            bytes.insert(bytes.end(), card.acronym.begin(), card.acronym.end());
+            writeVarint(bytes, card.schedule.due);
+            writeVarint(bytes, card.schedule.interval);
+            writeVarint(bytes, card.schedule.ease);
+            writeVarint(bytes, card.schedule.repetitions);
+        }
+    }
+    if (!header.deckFilter.empty()) {
+        writeVarint(bytes, header.deckFilter.size());
+        bytes.insert(bytes.end(), header.deckFilter.begin(), header.deckFilter.end());
+    }
+    if (header.streamBudget != 0) {
+        writeVarint(bytes, header.streamBudget);
+    }
+    lastTimeMillis = 0;
+}
+
+void ReplayRecorder::record(std::int64_t timeMillis, sf::Uint32 unicode) {
+    writeVarint(bytes, static_cast<std::uint64_t>(timeMillis - lastTimeMillis));
+    writeVarint(bytes, unicode);
+    lastTimeMillis = timeMillis;
+}
+
+bool ReplayRecorder::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Unable to write replay file: " << filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool loadReplay(const std::string& filename, Replay& replay) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: Unable to open replay file: " << filename << std::endl;
+        return false;
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() < 5 || !std::equal(std::begin(replayMagic), std::end(replayMagic), bytes.begin()) || bytes[4] < 1 || bytes[4] > replayVersion) {
+        std::cerr << "Error: Not a replay file (or unsupported version): " << filename << std::endl;
+        return false;
+    }
+
+    std::size_t offset = 5;
+    std::uint64_t seed = 0;
+    std::uint64_t gameMode = 0;
+    if (!readVarint(bytes, offset, seed) || !readVarint(bytes, offset, gameMode) || offset + 8 > bytes.size()) {
+        std::cerr << "Error: Truncated replay header: " << filename << std::endl;
+        return false;
+    }
+
+    replay = Replay();
+    replay.header.seed = static_cast<std::uint32_t>(seed);
+    replay.header.gameMode = static_cast<int>(gameMode);
+    for (int i = 0; i < 8; ++i) {
+        replay.header.deckHash |= static_cast<std::uint64_t>(bytes[offset++]) << (8 * i);
+    }
+
+    if (bytes[4] >= 2 && !readRoundOptions(bytes, offset, replay.header)) {
+        std::cerr << "Error: Truncated replay header: " << filename << std::endl;
+        return false;
+    }
+
+    std::int64_t timeMillis = 0;
+    while (offset < bytes.size()) {
+        std::uint64_t delta = 0;
+        std::uint64_t unicode = 0;
+        if (!readVarint(bytes, offset, delta) || !readVarint(bytes, offset, unicode)) {
+            std::cerr << "Error: Truncated replay event in " << filename << ", keeping " << replay.events.size() << " events" << std::endl;
+            break;
+        }
+        timeMillis += static_cast<std::int64_t>(delta);
+        replay.events.push_back({ timeMillis, static_cast<sf::Uint32>(unicode) });
+    }
+    return true;
+}
+
+void advanceReplay(GameState& game, const AcronymMap& acronyms, const Replay& replay, std::size_t& nextEvent, std::int64_t elapsedMillis) {
+    std::int64_t targetMillis = game.elapsedMillis + elapsedMillis;
+
+    while (nextEvent < replay.events.size() && replay.events[nextEvent].timeMillis <= targetMillis) {
+        const ReplayEvent& event = replay.events[nextEvent++];
+        advanceSimulation(game, event.timeMillis - game.elapsedMillis);
+        handleTextEntered(game, acronyms, event.unicode);
+    }
+
+    advanceSimulation(game, targetMillis - game.elapsedMillis);
+}
+
+GameState runReplayHeadless(const Replay& replay, const AcronymMap& acronyms, const AcronymWeights& weights,
+    const std::vector<sf::Vector2f>& spaceshipSizes, sf::Vector2f playfieldSize) {
+    QuestionScheduler scheduler(acronyms, weights);
+    scheduler.restore(replay.header.reviewStep, replay.header.schedule);
+
+    ShuffledDeck shuffledDeck(acronyms, replay.header.seed);
+
+    GameState game;
+    startGame(game, replay.header.gameMode, acronyms, spaceshipSizes, playfieldSize, replay.header.seed,
+        replay.header.spacedRepetition ? &scheduler : nullptr, replay.header.shuffled ? &shuffledDeck : nullptr);
+
+    // Step a second of game time at a time; the round always ends once the timer runs out
+    std::size_t nextEvent = 0;
+    while (!game.gameOver && !game.quitRequested) {
+        advanceReplay(game, acronyms, replay, nextEvent, 1000);
+    }
+    game.scheduler = nullptr;
+    game.shuffledDeck = nullptr;
+    return game;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "GameSimulation.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact binary recording of one round.
+//
+// File layout (all integers are LEB128 varints unless noted):
+//   "AIRP"            magic
+//   version           currently 4 (version 1 files have no flags byte and schedule, version 2 no filter,
+//                     version 3 no stream budget)
+//   seed              RNG seed passed to startGame
+//   gameMode          1, 2 or 3
+//   deckHash          8 bytes, little-endian, see hashDeck()
+//   flags             1 byte, bit 0: questions came from the spaced-repetition scheduler,
+//                             bit 1: questions came from a ShuffledDeck seeded with the round seed,
+//                             bit 2: the deck was narrowed down by a tag filter
+//                             bit 3: the deck was sampled from a deck file with --stream
+//   schedule          only with bit 0 set: the scheduler state at the start of the round
+//       reviewStep
+//       cardCount
+//       cards...      acronym length, acronym bytes, due, interval, ease, repetitions
+//   deckFilter        only with bit 2 set: length, then the filter text (see TagIndex.h)
+//   streamBudget      only with bit 3 set: the memory budget in bytes the file was sampled with
+//   events...         until end of file, each one:
+//       deltaMillis   game time since the previous event (first event: since the round started)
+//       unicode       the TextEntered code
+//
+// A typed character usually costs three bytes, so even an hour of constant typing stays
+// in the tens of kilobytes. Because the simulation runs on whole milliseconds, feeding the
+// events back at their recorded game times reproduces the round exactly.
+
+struct ReplayHeader {
+    std::uint32_t seed = 0;
+    int gameMode = 1;
+    std::uint64_t deckHash = 0;
+
+    // Scheduler state the round started from, so scheduled questions come up in the same order
+    bool spacedRepetition = false;
+    std::uint32_t reviewStep = 0;
+    std::vector<StoredCard> schedule;
+
+    // Questions cycled through the deck in shuffled order (--shuffle)
+    bool shuffled = false;
+
+    // Tag filter the deck was narrowed down by, empty for the whole deck; deckHash is of the narrowed deck
+    std::string deckFilter;
+
+    // With --stream, the budget the deck file was sampled with, 0 for a loaded deck. The reservoir
+    // only depends on the file and the budget, and the round's cards are drawn from it with the
+    // round seed, so playback samples the same deck again (see StreamingDeck.h).
+    std::uint64_t streamBudget = 0;
+};
+
+struct ReplayEvent {
+    std::int64_t timeMillis = 0; // Game time at which the event was applied
+    sf::Uint32 unicode = 0;
+};
+
+struct Replay {
+    ReplayHeader header;
+    std::vector<ReplayEvent> events;
+};
+
+// Function to fingerprint a deck, including its iteration order and weights (which drive question selection)
+std::uint64_t hashDeck(const AcronymMap& acronyms, const AcronymWeights& weights = AcronymWeights());
+
+// Encodes a round while it is being played
+class ReplayRecorder {
+public:
+    void begin(const ReplayHeader& header);
+    void record(std::int64_t timeMillis, sf::Uint32 unicode);
+    bool save(const std::string& filename) const;
+
+    std::size_t sizeInBytes() const { return bytes.size(); }
+
+private:
+    std::vector<std::uint8_t> bytes;
+    std::int64_t lastTimeMillis = 0;
+};
+
+// Function to read a replay file, returns false if it is missing or malformed
+bool loadReplay(const std::string& filename, Replay& replay);
+
+// Function to advance a round by elapsedMillis, applying each recorded event at its exact game time
+void advanceReplay(GameState& game, const AcronymMap& acronyms, const Replay& replay, std::size_t& nextEvent, std::int64_t elapsedMillis);
+
+// Function to play a whole replay as fast as possible without rendering, returns the final state
+// (with no scheduler or shuffled deck attached)
+GameState runReplayHeadless(const Replay& replay, const AcronymMap& acronyms, const AcronymWeights& weights,
+    const std::vector<sf::Vector2f>& spaceshipSizes, sf::Vector2f playfieldSize);
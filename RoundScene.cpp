@@ -0,0 +1,157 @@
+#include "RoundScene.h"
+#include "Profiler.h"
+#include <charconv>
+#include <cmath>
+#include <string>
+
+namespace {
+    const std::size_t explosionParticles = 600;
+    const char* const inputPrompt = "Input: (Press 'q' to Quit) ";
+
+    // Function to show a label such as "Time: 12"
+    void setNumberLabel(sf::Text& text, sf::String& label, std::string_view prefix, int value) {
+        char digits[16];
+        std::to_chars_result end = std::to_chars(digits, digits + sizeof(digits), value);
+        setTextLabel(text, label, prefix, std::string_view(digits, end.ptr - digits));
+    }
+}
+
+RoundScene::RoundScene(const sf::Font& font, const sf::Texture* backgroundTexture, const std::vector<const sf::Texture*>& spaceshipTextures,
+    BackgroundCache& background, ParticleSystem& particles, const DeckLayouts* questionLayouts, bool uploadChrome)
+    : backgroundTexture(backgroundTexture), spaceshipTextures(spaceshipTextures), background(background), particles(particles),
+      questionLayouts(questionLayouts), questionBottom(520 + font.getLineSpacing(24)) {
+    particles.clear();
+
+    // Scale the spaceship down
+    spaceshipSprite.setScale(spaceshipScale, spaceshipScale); // Scale down to 50% of its original size
+
+    // Text for the user's input
+    userInputText = sf::Text(inputPrompt, font, 24);
+    userInputText.setFillColor(sf::Color::White);
+    userInputText.setPosition(50, 550);
+
+    // Text for displaying full name of the acronym
+    fullNameText = sf::Text("", font, 24);
+    fullNameText.setFillColor(sf::Color::White);
+    fullNameText.setPosition(50, 520); // Position above the user input area
+
+    // The combined text background for the full name and user input, semi-transparent black above
+    // the user's input area
+    chrome.addRectangle(sf::FloatRect(40, 480, 700, 120), sf::Color(0, 0, 0, 150));
+    chrome.build(uploadChrome);
+
+    // Text for feedback messages
+    feedbackText = sf::Text("", font, 24);
+    feedbackText.setFillColor(sf::Color::Green);
+    feedbackText.setPosition(50, 485); // Position inside feedback box
+
+    // Timer display
+    timerText = sf::Text("Time: 30", font, 24);
+    timerText.setFillColor(sf::Color::White);
+    timerText.setPosition(50, 10); // Position at the top left
+
+    // Score display
+    scoreText = sf::Text("Score: 0", font, 24);
+    scoreText.setFillColor(sf::Color::White);
+    scoreText.setPosition(650, 10); // Position at the top right
+}
+
+void RoundScene::update(const FrameSnapshot& frame, float seconds) {
+    PROFILE_SCOPE("render.update");
+
+    // A hit blows the spaceship up where it was; hits between two drawn frames share one explosion
+    if (frame.hitCount != shownHits) {
+        shownHits = frame.hitCount;
+        particles.spawnExplosion(frame.hitPosition, explosionParticles);
+    }
+    {
+        PROFILE_SCOPE("particles.update");
+        particles.update(seconds);
+    }
+
+    if (const sf::Texture* texture = spaceshipTextures[frame.spaceshipTexture]) {
+        spaceshipSprite.setTexture(*texture);
+    }
+    spaceshipSprite.setPosition(frame.spaceshipPosition);
+    if (frame.questionText != shownQuestion) {
+        showQuestion(frame.questionText);
+    }
+    if (frame.feedback != shownFeedback) {
+        shownFeedback = frame.feedback;
+        feedbackText.setString(frame.feedback);
+    }
+    if (frame.userInput != shownInput) {
+        shownInput = frame.userInput;
+        setTextLabel(userInputText, inputLabel, inputPrompt, frame.userInput);
+    }
+    if (frame.timer != shownTimer) {
+        shownTimer = frame.timer;
+        setNumberLabel(timerText, timerLabel, "Time: ", frame.timer);
+    }
+    if (frame.score != shownScore) {
+        shownScore = frame.score;
+        setNumberLabel(scoreText, scoreLabel, "Score: ", frame.score);
+    }
+}
+
+void RoundScene::showQuestion(const std::string& question) {
+    shownQuestion = question;
+    auto layout = questionLayouts ? questionLayouts->find(question) : DeckLayouts::const_iterator();
+    if (!questionLayouts || layout == questionLayouts->end()) {
+        fullNameText.setString(question);
+        fullNameText.setCharacterSize(24);
+        fullNameText.setPosition(50, 520);
+        return;
+    }
+
+    // Wrapped questions grow upwards from the line above the user input, on whole pixels so the text stays sharp
+    fullNameText.setString(layout->second.text);
+    fullNameText.setCharacterSize(layout->second.characterSize);
+    fullNameText.setPosition(50, std::round(questionBottom - layout->second.height));
+}
+
+TextWrapStyle questionWrapStyle(const sf::Font& font) {
+    // Inside the combined box with 10px either side, in the space between the feedback and the user input
+    TextWrapStyle style;
+    style.width = 680;
+    style.height = 37;
+    for (unsigned characterSize : { 24u, 16u, 12u }) {
+        style.sizes.push_back(measureGlyphs(font, characterSize));
+    }
+    return style;
+}
+
+void RoundScene::draw(RenderBackend& backend) {
+    {
+        PROFILE_SCOPE("draw.background");
+        background.draw(backend, backgroundTexture);
+    }
+
+    {
+        PROFILE_SCOPE("draw.spaceship");
+        backend.draw(spaceshipSprite);
+    }
+
+    {
+        PROFILE_SCOPE("draw.particles");
+        backend.draw(particles);
+    }
+
+    {
+        PROFILE_SCOPE("draw.hud");
+
+        // Draw the feedback text
+        backend.draw(feedbackText);
+
+        // Draw the combined text background
+        backend.draw(chrome);
+
+        // Draw the full name of the acronym and the user's input
+        backend.draw(fullNameText);
+        backend.draw(userInputText);
+
+        // Draw the timer and score
+        backend.draw(timerText);
+        backend.draw(scoreText);
+    }
+}
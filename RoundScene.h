@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "GameSimulation.h"
+#include "ParticleSystem.h"
+#include "RenderBackend.h"
+#include "ScreenLayout.h"
+#include "TextLayout.h"
+#include "UiChrome.h"
+#include <string>
+#include <vector>
+
+// What the gameplay screen draws: the background, the spaceship, its explosions and the HUD.
+//
+// update() copies the newest FrameSnapshot into the sprites and texts, draw() issues the frame's
+// draw calls through a render backend, so the window and the headless runs share one frame.
+// Textures may be nullptr when drawing to the null backend, which never samples them.
+//
+// Questions are wrapped into the combined box with layouts made in the background (layoutDeck()
+// with questionWrapStyle()), so a new question is only a lookup. Without layouts, e.g. with the
+// null backend, which cannot measure glyphs, questions are shown on one line.
+//
+// A text is only set when what it shows changes, and the input, timer and score labels are composed
+// in sf::Strings kept from frame to frame (setTextLabel()), so a frame where nothing changed does not
+// touch them.
+class RoundScene {
+public:
+    RoundScene(const sf::Font& font, const sf::Texture* backgroundTexture, const std::vector<const sf::Texture*>& spaceshipTextures,
+        BackgroundCache& background, ParticleSystem& particles, const DeckLayouts* questionLayouts = nullptr, bool uploadChrome = true);
+
+    // Function to set the sprites and texts from a snapshot, and advance the particles by the time
+    // since the last frame
+    void update(const FrameSnapshot& frame, float seconds);
+
+    // Function to draw the frame; the caller clears and displays the backend
+    void draw(RenderBackend& backend);
+
+private:
+    // Function to show a new question, wrapped if it has a layout
+    void showQuestion(const std::string& question);
+
+    const sf::Texture* backgroundTexture;
+    std::vector<const sf::Texture*> spaceshipTextures;
+    BackgroundCache& background;
+    ParticleSystem& particles;
+    std::uint32_t shownHits = 0;
+
+    sf::Sprite spaceshipSprite;
+    sf::Text userInputText;
+    sf::Text fullNameText;
+    sf::Text feedbackText;
+    sf::Text timerText;
+    sf::Text scoreText;
+
+    // What the HUD texts show, as set in the constructor
+    std::string shownFeedback;
+    std::string shownInput;
+    int shownTimer = 30;
+    int shownScore = 0;
+
+    // Where the changing labels are composed, reused on every change
+    sf::String inputLabel;
+    sf::String timerLabel;
+    sf::String scoreLabel;
+
+    const DeckLayouts* questionLayouts;
+    std::string shownQuestion;
+    float questionBottom; // Where the last line of a question ends, just above the user input
+
+    // The round's static panels
+    UiChrome chrome;
+};
+
+// Function to measure the round's font for the questions in the combined box: 24px, or 16px or 12px
+// when that is what it takes to fit. Call it from the thread that draws with the font.
+TextWrapStyle questionWrapStyle(const sf::Font& font);
@@ -0,0 +1,76 @@
+#include "ScreenLayout.h"
+#include <cmath>
+#include <iostream>
+
+sf::IntRect letterboxPixels(sf::Vector2u windowSize) {
+    if (windowSize.x == 0 || windowSize.y == 0) {
+        return sf::IntRect(0, 0, 0, 0); // Minimised
+    }
+    float scale = std::fmin(windowSize.x / layoutSize.x, windowSize.y / layoutSize.y);
+    int width = static_cast<int>(std::lround(layoutSize.x * scale));
+    int height = static_cast<int>(std::lround(layoutSize.y * scale));
+    return sf::IntRect((static_cast<int>(windowSize.x) - width) / 2, (static_cast<int>(windowSize.y) - height) / 2, width, height);
+}
+
+sf::View letterboxView(sf::Vector2u windowSize) {
+    sf::View view(sf::FloatRect(0.0f, 0.0f, layoutSize.x, layoutSize.y));
+    sf::IntRect pixels = letterboxPixels(windowSize);
+    if (pixels.width > 0 && pixels.height > 0) {
+        view.setViewport(sf::FloatRect(
+            static_cast<float>(pixels.left) / windowSize.x, static_cast<float>(pixels.top) / windowSize.y,
+            static_cast<float>(pixels.width) / windowSize.x, static_cast<float>(pixels.height) / windowSize.y));
+    }
+    return view;
+}
+
+bool handleResizeEvent(sf::RenderWindow& window, const sf::Event& event) {
+    if (event.type != sf::Event::Resized) {
+        return false;
+    }
+    window.setView(letterboxView(sf::Vector2u(event.size.width, event.size.height)));
+    return true;
+}
+
+void BackgroundCache::draw(RenderBackend& backend, const sf::Texture* image) {
+    sf::Vector2u targetSize = backend.size();
+    sf::IntRect pixels = letterboxPixels(targetSize);
+    if (pixels.width <= 0 || pixels.height <= 0) {
+        return;
+    }
+    sf::Vector2u size(static_cast<unsigned>(pixels.width), static_cast<unsigned>(pixels.height));
+    if (backend.target() && image && (source != image || cachedSize != size) && !resample(*image, size)) {
+        return;
+    }
+
+    // Drawn in target pixels so every texel lands on exactly one pixel
+    sf::View layoutView = backend.getView();
+    backend.setView(sf::View(sf::FloatRect(0.0f, 0.0f, static_cast<float>(targetSize.x), static_cast<float>(targetSize.y))));
+    sprite.setPosition(static_cast<float>(pixels.left), static_cast<float>(pixels.top));
+    backend.draw(sprite);
+    backend.setView(layoutView);
+}
+
+bool BackgroundCache::resample(const sf::Texture& image, sf::Vector2u size) {
+    source = nullptr;
+    if (!scaled.create(size.x, size.y)) {
+        std::cerr << "Error creating a " << size.x << "x" << size.y << " background\n";
+        return false;
+    }
+
+    // A smoothed, mipmapped copy, so shrinking a large image averages its pixels instead of skipping them
+    sf::Texture filtered(image);
+    filtered.setSmooth(true);
+    filtered.generateMipmap();
+
+    sf::Sprite stretched(filtered);
+    stretched.setScale(static_cast<float>(size.x) / image.getSize().x, static_cast<float>(size.y) / image.getSize().y);
+    scaled.clear();
+    scaled.draw(stretched);
+    scaled.display();
+
+    sprite.setTexture(scaled.getTexture(), true);
+    source = &image;
+    cachedSize = size;
+    resamples++;
+    return true;
+}
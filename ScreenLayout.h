@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "RenderBackend.h"
+
+// Every screen is laid out for an 800x600 window. When the window has another size, the layout is
+// scaled uniformly to the largest size that fits and centred, with black bars on the two sides
+// that are left over (letterboxing), so positions given in layout units stay where they belong.
+const sf::Vector2f layoutSize(800.0f, 600.0f);
+
+// Function to compute the part of a window, in pixels, the layout is shown in
+sf::IntRect letterboxPixels(sf::Vector2u windowSize);
+
+// Function to make the view that shows the layout letterboxed in a window of the given size; set
+// it on the window when it opens and after every resize
+sf::View letterboxView(sf::Vector2u windowSize);
+
+// Function to re-letterbox the window after a Resized event; returns true if the event was one.
+// Only for the thread that draws to the window.
+bool handleResizeEvent(sf::RenderWindow& window, const sf::Event& event);
+
+// The background image resampled to the exact pixel size of the letterboxed area.
+//
+// Scaling a sprite from the original image size makes the GPU filter every pixel on every frame,
+// and with a plain texture a much larger image is sampled without mipmaps, so it shimmers. The
+// cache draws the image once into a render texture of the size it is shown at, smoothed and
+// mipmapped, and afterwards draws that texture 1:1. It resamples again only when the window size
+// or the image changes, so a resize costs one resample.
+//
+// Use it from the thread that draws to the window. With the null backend, or no image, nothing is
+// resampled but the blit is still issued, so it is counted like a real frame's.
+class BackgroundCache {
+public:
+    // Function to draw the background under the letterboxed layout, resampling first if needed
+    void draw(RenderBackend& backend, const sf::Texture* image);
+
+    // How often the image was resampled, to check that resizes do not resample every frame
+    unsigned resampleCount() const { return resamples; }
+
+private:
+    bool resample(const sf::Texture& image, sf::Vector2u size);
+
+    const sf::Texture* source = nullptr;
+    sf::Vector2u cachedSize;
+    sf::RenderTexture scaled;
+    sf::Sprite sprite;
+    unsigned resamples = 0;
+};
@@ -0,0 +1,123 @@
+#include "ShuffledDeck.h"
+
+namespace {
+    const std::uint32_t noIndex = 0xFFFFFFFF;
+
+    // SplitMix64 finalizer, used to derive per-cycle seeds and Feistel round keys
+    std::uint64_t mix64(std::uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+}
+
+ShuffledDeck::ShuffledDeck(const AcronymMap& acronyms, std::uint64_t seed)
+    : ShuffledDeck(acronyms, seed, acronyms.size() >= feistelThreshold ? Method::Feistel : Method::FisherYates) {
+}
+
+ShuffledDeck::ShuffledDeck(const AcronymMap& acronyms, std::uint64_t seed, Method method)
+    : permutationMethod(method) {
+    entries.reserve(acronyms.size());
+    for (const auto& entry : acronyms) {
+        entries.push_back(&entry);
+    }
+
+    // The Feistel network works on two equal halves, so round the domain up to a power of four;
+    // that is less than four times the deck size, so cycle-walking takes under four steps on average
+    int bits = 2;
+    while ((std::uint64_t(1) << bits) < entries.size()) {
+        bits += 2;
+    }
+    halfBits = bits / 2;
+    halfMask = (std::uint32_t(1) << halfBits) - 1;
+
+    reshuffle(seed);
+}
+
+void ShuffledDeck::reshuffle(std::uint64_t seed) {
+    baseSeed = seed;
+    cycleNumber = 0;
+    pendingIndex = noIndex;
+    startCycle(mix64(baseSeed));
+}
+
+const AcronymMap::value_type& ShuffledDeck::next() {
+    return *entries[nextIndex()];
+}
+
+void ShuffledDeck::startCycle(std::uint64_t cycleSeed) {
+    drawn = 0;
+    swapped.clear();
+    rng.seed(static_cast<std::uint32_t>(cycleSeed ^ (cycleSeed >> 32)));
+    for (std::uint64_t& key : roundKeys) {
+        cycleSeed = mix64(cycleSeed);
+        key = cycleSeed;
+    }
+}
+
+std::uint32_t ShuffledDeck::nextIndex() {
+    std::uint32_t index;
+    if (pendingIndex != noIndex) {
+        index = pendingIndex;
+        pendingIndex = noIndex;
+    }
+    else {
+        if (drawn == size()) {
+            cycleNumber++;
+            startCycle(mix64(baseSeed ^ mix64(cycleNumber)));
+        }
+
+        index = permutationMethod == Method::Feistel ? feistelNext() : fisherYatesNext();
+        drawn++;
+
+        // Hold back a card that would repeat the previous draw across a cycle boundary
+        if (index == lastIndex && drawn < size()) {
+            pendingIndex = index;
+            index = permutationMethod == Method::Feistel ? feistelNext() : fisherYatesNext();
+            drawn++;
+        }
+    }
+
+    lastIndex = index;
+    return index;
+}
+
+std::uint32_t ShuffledDeck::fisherYatesNext() {
+    // Swap position drawn with a random later position; unswapped positions hold their own index
+    std::uniform_int_distribution<std::uint32_t> positionDist(drawn, size() - 1);
+    std::uint32_t other = positionDist(rng);
+
+    auto lookup = [this](std::uint32_t position) {
+        auto it = swapped.find(position);
+        return it != swapped.end() ? it->second : position;
+    };
+    std::uint32_t card = lookup(other);
+    std::uint32_t displaced = lookup(drawn);
+
+    // Position drawn is never looked at again, so the map grows by at most one entry per draw
+    swapped[other] = displaced;
+    swapped.erase(drawn);
+    return card;
+}
+
+std::uint32_t ShuffledDeck::feistelNext() {
+    // Cycle-walking: apply the permutation of the larger domain until the result is a real card
+    std::uint32_t index = feistelPermute(drawn);
+    while (index >= size()) {
+        index = feistelPermute(index);
+    }
+    return index;
+}
+
+std::uint32_t ShuffledDeck::feistelPermute(std::uint32_t value) const {
+    std::uint32_t left = value >> halfBits;
+    std::uint32_t right = value & halfMask;
+    for (std::uint64_t key : roundKeys) {
+        std::uint32_t mixed = static_cast<std::uint32_t>(mix64(right ^ key)) & halfMask;
+        std::uint32_t newRight = left ^ mixed;
+        left = right;
+        right = newRight;
+    }
+    return (left << halfBits) | right;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Acronyms.h"
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// Walks a deck in shuffled order so every card comes up exactly once per cycle.
+//
+// Two ways of producing the permutation, both reproducible from a seed:
+//  - FisherYates: a lazily materialized Fisher-Yates shuffle. Only positions that have been
+//    swapped are stored, so each draw adds at most one entry however large the deck is.
+//  - Feistel: a keyed four-round Feistel network over the next power of four, cycle-walked until
+//    it lands inside the deck. Nothing is stored per draw at all, at the cost of a few hashes.
+//
+// When a cycle is used up the next one starts with a fresh shuffle derived from the seed, and the
+// first card of the new cycle is never the card that ended the previous one.
+class ShuffledDeck {
+public:
+    enum class Method { FisherYates, Feistel };
+
+    // Decks at least this large default to the Feistel permutation
+    static constexpr std::uint32_t feistelThreshold = 1u << 20;
+
+    // Function to shuffle a deck; the deck must outlive the iterator
+    ShuffledDeck(const AcronymMap& acronyms, std::uint64_t seed);
+    ShuffledDeck(const AcronymMap& acronyms, std::uint64_t seed, Method method);
+
+    // Function to start a new cycle in a new order, e.g. mid-session
+    void reshuffle(std::uint64_t seed);
+
+    // Function to return the next card of the cycle, starting a new cycle when this one is used up
+    const AcronymMap::value_type& next();
+
+    std::uint32_t size() const { return static_cast<std::uint32_t>(entries.size()); }
+    std::uint32_t position() const { return drawn; } // Cards drawn in the current cycle
+    std::uint64_t cycle() const { return cycleNumber; }
+    Method method() const { return permutationMethod; }
+
+private:
+    void startCycle(std::uint64_t cycleSeed);
+    std::uint32_t nextIndex();
+    std::uint32_t fisherYatesNext();
+    std::uint32_t feistelNext();
+    std::uint32_t feistelPermute(std::uint32_t value) const;
+
+    std::vector<const AcronymMap::value_type*> entries;
+    Method permutationMethod;
+    std::uint64_t baseSeed = 0;
+    std::uint64_t cycleNumber = 0;
+    std::uint32_t drawn = 0;
+    std::uint32_t lastIndex = 0xFFFFFFFF;    // Last card of the previous draw, to avoid a repeat across cycles
+    std::uint32_t pendingIndex = 0xFFFFFFFF; // Card held back one draw because it would have been that repeat
+
+    // Fisher-Yates state: position -> card for every position that is not the identity
+    std::mt19937 rng;
+    std::unordered_map<std::uint32_t, std::uint32_t> swapped;
+
+    // Feistel state
+    int halfBits = 1;
+    std::uint32_t halfMask = 1;
+    std::uint64_t roundKeys[4] = {};
+};
@@ -1,287 +1,595 @@
 #include <SFML/Graphics.hpp>
+#ifdef _WIN32
 #include <Windows.h>
-#include <sqlite3.h>
+#endif
 #include <unordered_map>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <sstream>   // For std::stringstream
 #include <algorithm> // For std::transform
 #include <cstdlib>   // For std::rand and std::srand
 #include <ctime>     // For std::time
 #include <vector>    // For std::vector
-
-// Helper function to trim whitespace from a string
-std::string trim(const std::string& str) {
-    size_t first = str.find_first_not_of(' ');
-    size_t last = str.find_last_not_of(' ');
-    return str.substr(first, (last - first + 1));
+#include <atomic>
+#include <thread>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include "Acronyms.h"
+#include "AllocationCounter.h"
+#include "AssetArchive.h"
+#include "AssetLoader.h"
+#include "DeckLibrary.h"
+#include "DeckWatcher.h"
+#include "EmbeddedAssets.h"
+#include "GameSimulation.h"
+#include "HighScores.h"
+#include "LatencyHistogram.h"
+#include "LaunchOptions.h"
+#include "Leaderboard.h"
+#include "ParticleSystem.h"
+#include "Profiler.h"
+#include "QuestionScheduler.h"
+#include "Replay.h"
+#include "RoundScene.h"
+#include "ScreenLayout.h"
+#include "ShuffledDeck.h"
+#include "SpscQueue.h"
+#include "StreamingDeck.h"
+#include "TagIndex.h"
+#include "TitleScene.h"
+#include "TripleBuffer.h"
+#include "UiChrome.h"
+
+// Assets, loaded in the background by AssetLoader and kept for every round
+const std::string titleFontFile = "Fonts/gyparody hv.ttf";
+const std::string gameFontFile = "Fonts/arial.ttf";
+const std::string backgroundFile = "Textures/background.jpg";
+
+// Function to list the spaceship textures, 1.png to 4.png
+std::vector<std::string> spaceshipFiles() {
+    std::vector<std::string> files;
+    for (int i = 1; i <= 4; ++i) {
+        files.push_back("Textures/" + std::to_string(i) + ".png");
+    }
+    return files;
 }
 
-// Function to load acronyms from a file
-std::unordered_map<std::string, std::string> loadAcronyms(const std::string& filename) {
-    std::unordered_map<std::string, std::string> acronyms;
-    std::ifstream file(filename);
+// Function to show a loading bar until the listed assets are ready, keeping the window responsive.
+// Returns false if the window was closed or an asset failed to load.
+bool waitForAssets(sf::RenderWindow& window, AssetLoader& assets, const std::vector<std::string>& files) {
+    UiChrome chrome;
+    chrome.addFrame(sf::FloatRect(200, 290, 400, 20), 2, sf::Color::White);
+    chrome.build();
+    sf::RectangleShape bar;
+    bar.setFillColor(sf::Color::Yellow);
+    bar.setPosition(200, 290);
+
+    while (window.isOpen()) {
+        assets.update();
+        if (assets.failed(files)) {
+            return false;
+        }
+        if (assets.ready(files)) {
+            return true;
+        }
+
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed)
+                window.close();
+            handleResizeEvent(window, event);
+        }
 
-    if (!file) {
-        std::cerr << "Error: Unable to open file: " << filename << std::endl;
-        return acronyms;
+        bar.setSize(sf::Vector2f(400 * assets.progress(), 20));
+        window.clear();
+        window.draw(chrome);
+        window.draw(bar);
+        window.display();
     }
+    return false;
+}
 
-    std::string line;
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string acronym, fullName;
+// Function to display the title screen; 'F' edits the tag filter the next rounds are limited to.
+// It only waits for its font; the background shows up once it is loaded, and the round's assets
+// keep loading while a mode is picked.
+int showTitleScreen(sf::RenderWindow& window, std::string& deckFilter, AssetLoader& assets, BackgroundCache& background) {
+    if (!waitForAssets(window, assets, { titleFontFile })) {
+        return window.isOpen() ? -1 : 0;
+    }
+    const sf::Font& font = *assets.font(titleFontFile);
 
-        // Split the line by the comma
-        if (std::getline(ss, acronym, ',') && std::getline(ss, fullName)) {
-            acronym = trim(acronym); // Trim any whitespace around the acronym
-            fullName = trim(fullName); // Trim any whitespace around the full name
+    TitleScene scene(font);
 
-            // Convert acronym to uppercase for consistency
-            std::transform(acronym.begin(), acronym.end(), acronym.begin(), ::toupper);
+    // Typed text goes to the tag filter until Enter is pressed
+    bool editingFilter = false;
 
-            acronyms[acronym] = fullName; // Store in map
+    // Display the title screen
+    WindowBackend backend(window);
+    while (window.isOpen()) {
+        assets.update();
+
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed)
+                window.close();
+            handleResizeEvent(window, event);
+            if (event.type == sf::Event::TextEntered && editingFilter) {
+                if (event.text.unicode == '\r' || event.text.unicode == '\n') {
+                    editingFilter = false;
+                }
+                else if (event.text.unicode == '\b') {
+                    if (!deckFilter.empty()) {
+                        deckFilter.pop_back();
+                    }
+                }
+                else if (event.text.unicode >= 32 && event.text.unicode < 128) {
+                    deckFilter += static_cast<char>(event.text.unicode);
+                }
+            }
+            else if (event.type == sf::Event::TextEntered) {
+                if (event.text.unicode == 'F' || event.text.unicode == 'f') {
+                    editingFilter = true;
+                }
+                else if (event.text.unicode == '1') {
+                    return 1; // Classic Mode selected
+                }
+                else if (event.text.unicode == '2') {
+                    return 2; // Timed Mode selected
+                }
+                else if (event.text.unicode == '3') {
+                    return 3; // Challenge Mode selected
+                }
+                else if (event.text.unicode == 'Q' || event.text.unicode == 'q') {
+                    window.close(); // Quit the game
+                }
+            }
         }
-    }
 
-    return acronyms;
+        scene.setFilter(deckFilter, editingFilter);
+
+        // Clear and draw title screen
+        backend.clear(); // Clear the window
+        scene.draw(backend, background, assets.texture(backgroundFile));
+        backend.display(); // Display everything
+    }
+    return 0; // In case of window close without selection
 }
 
-// Function to Initialize the Database
-void initializeDatabase() {
-    sqlite3* db;
-    int rc = sqlite3_open("highscores.db", &db);
-    if (rc) {
-        std::cerr << "Can't open database: " << sqlite3_errmsg(db) << "\n";
+// Function to load a whole deck for a run without a window: the deck file or directory on disk, or
+// else, like the windowed game, the copy in the asset archive or the executable. Returns false if
+// none of them has it.
+bool loadRunDeck(const std::string& deckPath, const AssetArchive& archive, DeckLibrary& library) {
+    std::error_code pathError;
+    if (std::filesystem::exists(deckPath, pathError)) {
+        return loadDeckLibrary(deckPath, library);
     }
-    else {
-        std::cout << "Opened database successfully\n";
+    std::string_view packedDeck;
+    if (archive.readText(deckPath, packedDeck)) {
+        return loadDeckText(deckPath, packedDeck, library);
     }
+    return loadEmbeddedDeck(deckPath, library);
+}
 
-    const char* createTableSQL = R"(
-        CREATE TABLE IF NOT EXISTS HighScores (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            player_name TEXT NOT NULL,
-            score INTEGER NOT NULL,
-            date_time TIMESTAMP DEFAULT CURRENT_TIMESTAMP
-        );
-    )";
+// Function to find the spaceship images for loadSpaceshipSizes in the archive or the executable
+AssetLookup archiveLookup(const AssetArchive& archive) {
+    return [&archive](const std::string& file, const void*& data, std::size_t& size) {
+        return findAssetInMemory(&archive, file, data, size);
+    };
+}
 
-    char* errorMessage;
-    rc = sqlite3_exec(db, createTableSQL, nullptr, nullptr, &errorMessage);
-    if (rc != SQLITE_OK) {
-        std::cerr << "SQL error: " << errorMessage << "\n";
-        sqlite3_free(errorMessage);
+// Function to play a replay without a window and print how the round ended. A streamed round is
+// played on the same sample of the deck file, drawn again with its budget and seed.
+int runFastReplay(const Replay& replay, const LaunchOptions& options, const AssetArchive& archive) {
+    DeckLibrary library;
+    if (replay.header.streamBudget > 0) {
+        StreamingDeck streaming(options.deckPath, static_cast<std::size_t>(replay.header.streamBudget));
+        std::shared_ptr<DeckSnapshot> deck = streaming.drawRound(replay.header.seed);
+        if (deck) {
+            library = std::move(deck->library);
+        }
     }
     else {
-        std::cout << "Table created successfully\n";
+        loadRunDeck(options.deckPath, archive, library);
     }
-
-    sqlite3_close(db);
-}
-
-void insertScore(const std::string& playerName, int score) {
-    sqlite3* db;
-    sqlite3_open("highscores.db", &db);
-
-    // Check if the score already exists for this player
-    std::string checkSql = "SELECT COUNT(*) FROM highscores WHERE player_name = '" + playerName + "' AND score = " + std::to_string(score) + ";";
-    
-    sqlite3_stmt* stmt;
-    sqlite3_prepare_v2(db, checkSql.c_str(), -1, &stmt, nullptr);
-    int result = sqlite3_step(stmt);
-
-    if (result == SQLITE_ROW) {
-        int count = sqlite3_column_int(stmt, 0);
-        if (count > 0) {
-            // If the score is already in the database, skip the insert
-            std::cout << "Score already exists for player: " << playerName << " with score: " << score << std::endl;
-            sqlite3_finalize(stmt);
-            sqlite3_close(db);
-            return;
+    if (library.acronyms.empty()) {
+        std::cerr << "Error: --fast needs the deck the replay was recorded with, " << options.deckPath << " has no acronyms\n";
+        return -1;
+    }
+    AcronymMap& acronyms = library.acronyms;
+    const AcronymWeights& weights = library.weights;
+    if (!replay.header.deckFilter.empty()) {
+        TagIndex tagIndex(acronyms, library.tags);
+        CardSet cards;
+        if (tagIndex.evaluate(replay.header.deckFilter, cards)) {
+            AcronymMap filtered = tagIndex.subDeck(cards);
+            acronyms = std::move(filtered);
         }
     }
+    if (hashDeck(acronyms, weights) != replay.header.deckHash) {
+        std::cerr << "Warning: The deck differs from the one the replay was recorded with, playback will diverge\n";
+    }
 
-    sqlite3_finalize(stmt);
+    // Only the spaceship sizes are needed, so decode the images without creating textures
+    std::vector<sf::Vector2f> spaceshipSizes;
+    if (!loadSpaceshipSizes(spaceshipSizes, archiveLookup(archive))) {
+        return -1;
+    }
 
-    // If the score does not exist, insert the score into the database
-    std::string sql = "INSERT INTO HighScores (player_name, score) VALUES ('" + playerName + "', " + std::to_string(score) + ");";
+    sf::Clock wallClock;
+    GameState game = runReplayHeadless(replay, acronyms, weights, spaceshipSizes, layoutSize);
+    std::cout << "Replay finished in " << wallClock.getElapsedTime().asMilliseconds() << "ms: "
+        << replay.events.size() << " events, " << game.elapsedMillis << "ms of game time, "
+        << "score " << game.score << ", timer " << game.timer << (game.quitRequested ? ", quit" : ", game over") << "\n";
+    return 0;
+}
 
-    char* errMessage = nullptr;
-    if (sqlite3_exec(db, sql.c_str(), 0, 0, &errMessage) != SQLITE_OK) {
-        std::cerr << "Error inserting score into database: " << errMessage << std::endl;
-        sqlite3_free(errMessage);
+// Scores shown on the captured leaderboard, so the frame does not depend on the local database
+const std::vector<std::pair<std::string, int>> captureScores = {
+    { "Ada", 4200 }, { "Grace", 3900 }, { "Linus", 3100 }, { "Margaret", 2800 }, { "Dennis", 2300 },
+    { "Barbara", 1900 }, { "Ken", 1500 }, { "Radia", 1100 }, { "Alan", 600 }, { "Anonymous", 100 }
+};
+
+// The gameplay frame saved by --capture, a few answers into the first round
+const std::size_t capturedGameplayFrame = 150;
+
+// Function to save the last frame drawn offscreen as DIRECTORY/NAME.png
+bool saveCapturedFrame(const TextureBackend& backend, const std::string& directory, const std::string& name) {
+    std::string file = directory + "/" + name + ".png";
+    if (!backend.result().copyToImage().saveToFile(file)) {
+        std::cerr << "Error saving " << file << "\n";
+        return false;
     }
+    std::cout << "Captured " << file << "\n";
+    return true;
+}
 
-    sqlite3_close(db);
+// Function to play rounds with a typing bot and no window, drawing every frame through the null backend
+// (draw calls are only counted) or into an offscreen texture, and print frame-time statistics. Each frame
+// steps 16ms of game time, so runs with the same deck and frame count do the same work.
+//
+// With --capture it draws offscreen and saves the title, gameplay and leaderboard frames as PNGs for
+// "Frame Diff.exe" to compare against the goldens. The seed, the clock, the bot and the leaderboard's
+// scores are all fixed, so the frames only change when the drawing, the assets or the deck do.
+int runHeadless(const LaunchOptions& options, const AssetArchive& archive) {
+    DeckLibrary library;
+    if (!loadRunDeck(options.deckPath, archive, library) || library.acronyms.empty()) {
+        std::cerr << "Error: --headless needs a deck with at least one acronym\n";
+        return -1;
+    }
+    const AcronymMap& acronyms = library.acronyms;
+
+    bool capturing = !options.captureDirectory.empty();
+    std::string backendName = capturing ? "texture" : options.renderBackend;
+    std::size_t frameCount = capturing ? capturedGameplayFrame + 1 : options.headlessFrames;
+    std::error_code directoryError;
+    if (capturing && !std::filesystem::create_directories(options.captureDirectory, directoryError) && directoryError) {
+        std::cerr << "Error creating " << options.captureDirectory << ": " << directoryError.message() << "\n";
+        return -1;
+    }
 
-}
+    // The texture backend needs a GL context (a software one is enough); the null backend never creates one
+    sf::Vector2u frameSize(static_cast<unsigned>(layoutSize.x), static_cast<unsigned>(layoutSize.y));
+    std::unique_ptr<RenderBackend> backend;
+    TextureBackend* textureBackend = nullptr;
+    if (backendName == "texture") {
+        auto offscreen = std::make_unique<TextureBackend>();
+        if (!offscreen->create(frameSize.x, frameSize.y)) {
+            std::cerr << "Error creating the offscreen render texture\n";
+            return -1;
+        }
+        textureBackend = offscreen.get();
+        backend = std::move(offscreen);
+    }
+    else {
+        backend = std::make_unique<NullBackend>(frameSize);
+    }
+    bool drawing = backend->target() != nullptr;
+    backend->setView(letterboxView(backend->size()));
+
+    // Textures are only loaded when something is drawn; the null backend needs just the font
+    AssetLoader assets(archive.isOpen() ? &archive : nullptr);
+    std::vector<std::string> files = { gameFontFile };
+    assets.requestFont(gameFontFile);
+    if (capturing) {
+        files.push_back(titleFontFile);
+        assets.requestFont(titleFontFile);
+    }
+    if (drawing) {
+        files.push_back(backgroundFile);
+        assets.requestTexture(backgroundFile);
+        for (const std::string& file : spaceshipFiles()) {
+            files.push_back(file);
+            assets.requestTexture(file);
+        }
+    }
+    while (!assets.ready(files)) {
+        assets.update();
+        if (assets.failed(files)) {
+            return -1;
+        }
+        sf::sleep(sf::milliseconds(1));
+    }
 
+    std::vector<const sf::Texture*> spaceshipTextures;
+    for (const std::string& file : spaceshipFiles()) {
+        spaceshipTextures.push_back(assets.texture(file));
+    }
+    std::vector<sf::Vector2f> spaceshipSizes;
+    if (drawing) {
+        for (const sf::Texture* texture : spaceshipTextures) {
+            spaceshipSizes.emplace_back(texture->getSize().x * spaceshipScale, texture->getSize().y * spaceshipScale);
+        }
+    }
+    else if (!loadSpaceshipSizes(spaceshipSizes, archiveLookup(archive))) {
+        return -1;
+    }
 
+    // Questions are only wrapped when drawing, since measuring the font needs GL
+    BackgroundCache background;
+    const sf::Font& font = *assets.font(gameFontFile);
+    std::shared_ptr<const DeckLayouts> questionLayouts;
+    if (drawing) {
+        questionLayouts = layoutDeck(acronyms, questionWrapStyle(font));
+    }
+    // The usual pool, or one large enough for --particles, which LaunchOptions caps at a million
+    ParticleSystem particles(std::max<std::size_t>(100000, options.stressParticles));
+    RoundScene scene(font, assets.texture(backgroundFile), spaceshipTextures, background, particles, questionLayouts.get(), drawing);
+
+    // The screens around the round are the same every run, so they are captured once up front
+    if (capturing) {
+        TitleScene title(*assets.font(titleFontFile));
+        title.setFilter(std::string(), false);
+        backend->clear();
+        title.draw(*backend, background, assets.texture(backgroundFile));
+        backend->display();
+        if (!saveCapturedFrame(*textureBackend, options.captureDirectory, "title")) {
+            return -1;
+        }
 
+        LeaderboardScene leaderboard(font);
+        backend->clear();
+        background.draw(*backend, assets.texture(backgroundFile));
+        leaderboard.draw(*backend, captureScores);
+        backend->display();
+        if (!saveCapturedFrame(*textureBackend, options.captureDirectory, "leaderboard")) {
+            return -1;
+        }
+    }
 
-// Function to get top scores from the database
-std::vector < std::pair < std::string, int >> getTopScores() {
-    sqlite3* db;
-    sqlite3_open("highscores.db", &db);
+    const std::int64_t frameMillis = 16;
+    const std::size_t framesPerKey = 6; // The bot types about ten characters a second
+    unsigned int seed = 1;
+    GameState game;
+    startGame(game, 1, acronyms, spaceshipSizes, layoutSize, seed);
+
+    FrameSnapshot frame;
+    LatencyHistogram frameTimes;
+    std::size_t typed = 0;
+    std::size_t rounds = 1;
+    std::uint64_t drawCalls = 0;
+    std::uint64_t allocations = 0;   // Heap allocations of the whole frame, bot and simulation included
+    std::size_t allocatingFrames = 0;
+    sf::Clock wallClock;
+    for (std::size_t i = 0; i < frameCount; ++i) {
+        std::int64_t frameStart = steadyMicros();
+
+        // Type the current acronym one character at a time, then Enter
+        if (i % framesPerKey == 0) {
+            if (typed < game.currentAcronym.size()) {
+                handleTextEntered(game, acronyms, static_cast<unsigned char>(game.currentAcronym[typed++]));
+            }
+            else {
+                handleTextEntered(game, acronyms, 13);
+                typed = 0;
+            }
+        }
+        advanceSimulation(game, frameMillis);
+        if (game.gameOver || game.quitRequested) {
+            startGame(game, 1, acronyms, spaceshipSizes, layoutSize, ++seed);
+            typed = 0;
+            rounds++;
+        }
+        writeSnapshot(game, frame);
 
-    std::vector<std::pair<std::string, int >> topScores;
+        // With --particles, explosions across the screen keep the pool topped up
+        for (std::size_t burst = 0; particles.liveCount() + 1000 <= options.stressParticles; ++burst) {
+            float x = 100.0f + static_cast<float>((i * 7 + burst) * 137 % 600);
+            particles.spawnExplosion(sf::Vector2f(x, 100.0f + static_cast<float>((i + burst) * 89 % 300)), 1000);
+        }
 
-    std::string sql = "SELECT player_name, score FROM HighScores ORDER BY score DESC LIMIT 10;";
-    sqlite3_stmt* stmt;
+        scene.update(frame, frameMillis / 1000.0f);
+        backend->clear();
+        scene.draw(*backend);
+        backend->display();
 
-    if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
-            std::string playerName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
-            int score = sqlite3_column_int(stmt, 1);
-            topScores.emplace_back(playerName, score);
+        drawCalls += backend->frameDrawCalls();
+        allocations += backend->frameAllocations();
+        if (backend->frameAllocations() > 0) {
+            allocatingFrames++;
         }
+        frameTimes.record(steadyMicros() - frameStart);
     }
-
-    else {
-        std::cerr << "Error querying top scores: " << sqlite3_errmsg(db) << std::endl;
+    if (capturing && !saveCapturedFrame(*textureBackend, options.captureDirectory, "gameplay")) {
+        return -1;
     }
 
-    sqlite3_finalize(stmt);
-    sqlite3_close(db);
-
-    return topScores;
-}
-
-// Function to display high scores in the game window
-void displayHighScores(sf::RenderWindow& window, const sf::Font& font, const std::vector < std::pair < std::string, int>>& topScores) {
-
-    sf::Text title("Top 10 High Scores", font, 30);
-    title.setFillColor(sf::Color::Yellow);
-    title.setPosition(85, 50);
-    window.draw(title);
-
-    // Create a table for the table header
-    sf::RectangleShape tableHeader(sf::Vector2f(350, 40)); // Table width & height of header
-    tableHeader.setFillColor(sf::Color(0, 0, 0, 150)); // Semi-transparent black background
-    tableHeader.setPosition(50, 100); // Set position for header row
-    window.draw(tableHeader);
-
-    // Create a table for the high scores
-    sf::RectangleShape table(sf::Vector2f(350, 400));
-    table.setFillColor(sf::Color(0, 0, 0, 150));
-    table.setPosition(50, 150);
-    window.draw(table);
-
-    // Title for the columns (Name and Score)
-    sf::Text nameHeader("Name", font, 24);
-    nameHeader.setFillColor(sf::Color::White);
-    nameHeader.setPosition(85, 110); // Position of the column header
-    window.draw(nameHeader);
-    
-    sf::Text scoreHeader("Score", font, 24);
-    scoreHeader.setFillColor(sf::Color::White);
-    scoreHeader.setPosition(225, 110);
-    window.draw(scoreHeader);
-
-    // Display the high scores in the table
-    float yOffset = 155.0f; // Starting position for displaying the top 10 scores
-    for (size_t i = 0; i < topScores.size(); ++i) {
-        sf::Text playerName(std::to_string(i + 1) + ". " + topScores[i].first, font, 24);
-        playerName.setFillColor(sf::Color::White);
-        playerName.setPosition(60, yOffset);
-        
-        sf::Text score(std::to_string(topScores[i].second), font, 24);
-        score.setFillColor(sf::Color::White);
-        score.setPosition(225, yOffset);
-            
-        window.draw(playerName);
-        window.draw(score);
-
-        yOffset += 40.0f;
+    std::cout << "Headless run with the " << backendName << " backend: " << frameCount << " frames, "
+        << rounds << (rounds == 1 ? " round" : " rounds") << ", score " << game.score << ", " << particles.liveCount() << " particles, "
+        << wallClock.getElapsedTime().asMilliseconds() << "ms\n";
+    std::cout << "Draw calls per frame: " << static_cast<double>(drawCalls) / frameCount << "\n";
+    if (allocationCountingEnabled) {
+        std::cout << "Heap allocations per frame: " << static_cast<double>(allocations) / frameCount << ", "
+            << allocatingFrames << " of " << frameCount << " frames allocated\n";
     }
+    std::cout << "Frame time: " << formatLatencySummary(frameTimes.summary()) << "\n";
+    return 0;
 }
 
-// Function to display the title screen
-int showTitleScreen(sf::RenderWindow& window) {
-    sf::Font font;
-    if (!font.loadFromFile("Fonts/gyparody hv.ttf")) {
-        std::cerr << "Error loading font\n";
-        return -1;
+// Function to save a round's answers under the name entered at game over. The round was scheduled
+// from roundPlayer's state; if someone else entered their name, the answers are applied to theirs.
+void saveRoundSchedule(const QuestionScheduler& scheduler, const std::string& roundPlayer, const std::string& playerName,
+    const AcronymMap& acronyms, const AcronymWeights& weights) {
+    if (playerName == roundPlayer) {
+        saveCardSchedules(playerName, scheduler.reviewStep(), scheduler.changedCards());
+        return;
     }
 
-    // Load background texture
-    sf::Texture backgroundTexture;
-    if (!backgroundTexture.loadFromFile("Textures/background.jpg")) {
-        std::cerr << "Error loading background texture\n";
-        return -1;
+    std::uint32_t reviewStep = 0;
+    std::vector<StoredCard> storedCards;
+    if (!loadCardSchedules(playerName, reviewStep, storedCards)) {
+        return;
+    }
+    QuestionScheduler playerScheduler(acronyms, weights);
+    playerScheduler.restore(reviewStep, storedCards);
+    for (const QuestionScheduler::Review& review : scheduler.reviews()) {
+        playerScheduler.answer(review.card, review.correct);
     }
+    saveCardSchedules(playerName, playerScheduler.reviewStep(), playerScheduler.changedCards());
+}
 
-    sf::Sprite backgroundSprite(backgroundTexture);
+// The deck version and question scheduler of one round; the scheduler points into the deck, so
+// both stay in place
+struct RoundQuestions {
+    unsigned int seed = 0;                  // The round's seed; a streamed deck is sampled with it
+    std::shared_ptr<const DeckSnapshot> deck;
+    AcronymMap filteredAcronyms;            // The cards matching the tag filter, if there is one
+    const AcronymMap* acronyms = nullptr;   // deck->library.acronyms or filteredAcronyms
+    std::unique_ptr<QuestionScheduler> scheduler;
+
+    // The deck's questions wrapped for the combined box; a filtered deck uses the same layouts
+    std::shared_ptr<const DeckLayouts> questionLayouts;
+
+    // The player's saved schedule, kept to reschedule a filtered deck
+    std::uint32_t reviewStep = 0;
+    std::vector<StoredCard> storedCards;
+
+    const AcronymWeights& weights() const { return deck->library.weights; }
+};
+
+// Where rounds take their deck from: the watched deck file or directory, or with --stream a new
+// sample of a deck file too large to load
+struct RoundDecks {
+    std::unique_ptr<DeckWatcher> watcher;
+    std::unique_ptr<StreamingDeck> streaming;
+    std::shared_ptr<const DeckSnapshot> packed; // The deck from the asset archive, when there is no loose deck file
+
+    // Function to return the deck for the next round; a streamed deck is sampled with the round's
+    // seed, so its replay can sample it again. Streaming reads from disk, so it is only called while
+    // preparing a round in the background.
+    std::shared_ptr<const DeckSnapshot> next(unsigned int seed) {
+        if (packed) {
+            return packed;
+        }
+        if (!streaming) {
+            return watcher->current();
+        }
+        std::shared_ptr<DeckSnapshot> deck = streaming->drawRound(seed);
+        if (!deck) {
+            deck = std::make_shared<DeckSnapshot>();
+            deck->tagIndex = std::make_unique<TagIndex>(deck->library.acronyms, deck->library.tags);
+        }
+        return deck;
+    }
 
-    // Scale the background sprite to fit the window
-    backgroundSprite.setScale(
-        static_cast<float>(window.getSize().x) / backgroundTexture.getSize().x,
-        static_cast<float>(window.getSize().y) / backgroundTexture.getSize().y
-    );
+    // Function to check whether the deck file was edited since a round's deck was taken
+    bool outdated(const DeckSnapshot& deck) const {
+        return watcher && deck.generation != watcher->generation();
+    }
+};
+
+// Function to take the newest deck version, load the player's schedule, build the sampling tables
+// and, once the game font is measured, lay out the questions. It runs in the background while the
+// title screen or leaderboard is up, so a large deck does not delay the round.
+std::unique_ptr<RoundQuestions> prepareRoundQuestions(RoundDecks& decks, const std::string& playerName, unsigned int seed,
+    std::shared_ptr<const TextWrapStyle> questionStyle) {
+    auto questions = std::make_unique<RoundQuestions>();
+    questions->seed = seed;
+    questions->deck = decks.next(seed);
+    questions->acronyms = &questions->deck->library.acronyms;
+    questions->scheduler = std::make_unique<QuestionScheduler>(*questions->acronyms, questions->weights());
+    if (questionStyle) {
+        questions->questionLayouts = layoutDeck(*questions->acronyms, *questionStyle);
+    }
 
-    // Title text
-    sf::Text title("Acronym Invaders!", font, 50);
-    title.setFillColor(sf::Color::Yellow);
-    title.setPosition(200, 100);
+    if (!playerName.empty() && loadCardSchedules(playerName, questions->reviewStep, questions->storedCards)) {
+        questions->scheduler->restore(questions->reviewStep, questions->storedCards);
+    }
+    return questions;
+}
 
-    // Game mode options
-    sf::Text mode1("1. Acronym Mode", font, 30);
-    mode1.setFillColor(sf::Color::White);
-    mode1.setPosition(300, 250);
+// Function to narrow a round down to the cards matching a tag filter. Every way of picking questions
+// then draws from the narrowed deck directly. Returns false, keeping the whole deck, if the filter is
+// invalid or matches nothing.
+bool applyDeckFilter(RoundQuestions& questions, const std::string& deckFilter) {
+    CardSet cards;
+    if (!questions.deck->tagIndex->evaluate(deckFilter, cards)) {
+        return false;
+    }
+    if (cards.empty()) {
+        std::cerr << "No acronyms match the deck filter: " << deckFilter << "\n";
+        return false;
+    }
 
-    sf::Text mode2("2. Term Mode", font, 30);
-    mode2.setFillColor(sf::Color::White);
-    mode2.setPosition(300, 300);
+    questions.filteredAcronyms = questions.deck->tagIndex->subDeck(cards);
+    questions.acronyms = &questions.filteredAcronyms;
+    questions.scheduler = std::make_unique<QuestionScheduler>(*questions.acronyms, questions.weights());
+    questions.scheduler->restore(questions.reviewStep, questions.storedCards);
+    return true;
+}
 
-    sf::Text mode3("3. Challenge Mode", font, 30);
-    mode3.setFillColor(sf::Color::White);
-    mode3.setPosition(300, 350);
+// Function to run the game with the process arguments
+int runGame(int argc, char** argv) {
+    LaunchOptions options = parseLaunchOptions(argc, argv);
 
-    sf::Text exit("Press 'Q' to Quit", font, 24);
-    exit.setFillColor(sf::Color::White);
-    exit.setPosition(300, 400);
+    // Textures, fonts and the default deck come from one mapped archive when it exists, so start-up
+    // opens one file instead of one per asset; without it, e.g. during development, the loose files are used
+    AssetArchive archive;
+    if (archive.open(options.assetArchive)) {
+        std::cout << "Using " << archive.size() << " assets from " << options.assetArchive << "\n";
+    }
 
-    // Display the title screen
-    while (window.isOpen()) {
-        sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
-                window.close();
-            if (event.type == sf::Event::TextEntered) {
-                if (event.text.unicode == '1') {
-                    return 1; // Classic Mode selected
-                }
-                else if (event.text.unicode == '2') {
-                    return 2; // Timed Mode selected
-                }
-                else if (event.text.unicode == '3') {
-                    return 3; // Challenge Mode selected
-                }
-                else if (event.text.unicode == 'Q' || event.text.unicode == 'q') {
-                    window.close(); // Quit the game
-                }
-            }
+    // A replay replaces the title screen and keyboard input; with --fast no window is opened at all
+    Replay replay;
+    bool replaying = !options.replayFile.empty();
+    if (replaying) {
+        if (!loadReplay(options.replayFile, replay)) {
+            return -1;
+        }
+        if (options.fastReplay) {
+            return runFastReplay(replay, options, archive);
         }
-
-        // Clear and draw title screen
-        window.clear(); // Clear the window
-        window.draw(backgroundSprite); // Draw the background
-        window.draw(title); // Draw title text
-        window.draw(mode1); // Draw mode 1 text
-        window.draw(mode2); // Draw mode 2 text
-        window.draw(mode3); // Draw mode 3 text
-        window.draw(exit);  // Draw ext text
-        window.display();   // Display everything
     }
-    return 0; // In case of window close without selection
-}
 
+    // Benchmark runs draw without a window
+    if (options.headless) {
+        return runHeadless(options, archive);
+    }
 
-// Entry point for Windows applications
-int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd) {
     sf::RenderWindow window(sf::VideoMode(800, 600), "Acronym Invaders!");
+    window.setView(letterboxView(window.getSize()));
+
+    // The background resampled to the window size, shared by every screen so it is only redone on a resize
+    BackgroundCache background;
+
+    // The explosions' particles, allocated once for every round
+    ParticleSystem particles;
+
+    // Fonts and textures load on worker threads from here on; the title screen only waits for its
+    // font, and the first round for the rest
+    AssetLoader assets(archive.isOpen() ? &archive : nullptr);
+    assets.requestFont(titleFontFile);
+    assets.requestTexture(backgroundFile);
+    std::vector<std::string> roundAssets = { gameFontFile, backgroundFile };
+    for (const std::string& file : spaceshipFiles()) {
+        assets.requestTexture(file);
+        roundAssets.push_back(file);
+    }
+    assets.requestFont(gameFontFile);
 
     // Game loop control variable
     bool playAgain = true; // Game loop control
@@ -289,341 +597,355 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     // Initialize the Database
     initializeDatabase();
 
+    // Questions are scheduled for whoever saved the last score until another name is entered
+    std::string currentPlayer = options.playerName.empty() ? getLastPlayerName() : options.playerName;
+    if (currentPlayer.empty()) {
+        currentPlayer = "Anonymous";
+    }
+
+    // Tag filter chosen on the title screen, kept for the following rounds
+    std::string deckFilter = options.deckFilter;
+
+    // The deck (acronyms.txt or --decks) is reloaded in the background whenever it is saved; each
+    // round uses the newest version. With --stream every round gets a new sample of the deck instead,
+    // drawn with the round's seed; a replay of a streamed round samples the file again with the budget
+    // it was recorded with, and a replay of any other round loads the whole deck. When the deck file
+    // is not on disk, the copy in the asset archive or the executable is used for every round.
+    RoundDecks decks;
+    std::size_t streamBudget = replaying ? static_cast<std::size_t>(replay.header.streamBudget) : options.streamMegabytes << 20;
+    std::error_code pathError;
+    std::string_view packedDeck;
+    if (!std::filesystem::exists(options.deckPath, pathError)) {
+        if (archive.readText(options.deckPath, packedDeck)) {
+            decks.packed = loadDeckSnapshot(options.deckPath, packedDeck);
+        }
+        else {
+            decks.packed = loadEmbeddedDeckSnapshot(options.deckPath);
+        }
+    }
+    // A packed deck leaves nothing on disk to watch or stream
+    if (!decks.packed && streamBudget > 0 && !std::filesystem::is_directory(options.deckPath, pathError)) {
+        decks.streaming = std::make_unique<StreamingDeck>(options.deckPath, streamBudget);
+    }
+    else if (!decks.packed) {
+        if (streamBudget > 0) {
+            std::cerr << "Warning: --stream needs a single deck file, loading " << options.deckPath << " instead\n";
+        }
+        decks.watcher = std::make_unique<DeckWatcher>(options.deckPath);
+    }
+
+    // How questions are wrapped, measured from the game font before the first round
+    std::shared_ptr<const TextWrapStyle> questionStyle;
+
+    // Each round's seed is picked when its questions are prepared, since a streamed deck is sampled with it
+    auto roundSeed = [&]() {
+        return replaying ? replay.header.seed : static_cast<unsigned int>(std::time(0));
+    };
+
+    // Questions for the next round are prepared while the title screen is showing; a replay brings its own schedule
+    std::future<std::unique_ptr<RoundQuestions>> nextQuestions = std::async(std::launch::async, prepareRoundQuestions,
+        std::ref(decks), replaying ? std::string() : currentPlayer, roundSeed(), questionStyle);
+
     while (playAgain) {
 
         // Show the title Screen and get the selected game momde
-        int gameMode = showTitleScreen(window);
+        int gameMode = replaying ? replay.header.gameMode : showTitleScreen(window, deckFilter, assets, background);
         if (gameMode == 0) {
             break; // Exit the game if the window was closed
         }
 
-        // Load the acronyms from the acronyms.txt file
-        std::unordered_map<std::string, std::string> acronyms = loadAcronyms("acronyms.txt");
-
-        // Load background texture
-        sf::Texture backgroundTexture;
-        if (!backgroundTexture.loadFromFile("Textures/background.jpg")) {
-            std::cerr << "Error loading background texture\n";
-            return -1;
+        // Use the questions prepared in the background, unless the deck was edited since
+        if (!nextQuestions.valid()) {
+            nextQuestions = std::async(std::launch::deferred, prepareRoundQuestions, std::ref(decks), currentPlayer, roundSeed(), questionStyle);
         }
-        sf::Sprite backgroundSprite(backgroundTexture);
-
-        // Scale the background sprite to fit the window
-        backgroundSprite.setScale(
-            static_cast<float>(window.getSize().x) / backgroundTexture.getSize().x,
-            static_cast<float>(window.getSize().y) / backgroundTexture.getSize().y
-        );
-
-        // Load multiple spaceship textures
-        std::vector<sf::Texture> spaceshipTextures;
-        std::string basePath = "Textures/"; // Define the new directory path
-        for (int i = 1; i <= 4; ++i) { // Assuming you have 4 spaceship images named 1.png, 2.png, 3.png, and 4.png
-            sf::Texture texture;
-            std::string filePath = basePath + std::to_string(i) + ".png"; // Concatenate the directory path with the filename
-            if (!texture.loadFromFile(filePath)) {
-                std::cerr << "Error loading spaceship texture " << i << " from " << filePath << "\n";
-                return -1;
-            }
-            spaceshipTextures.push_back(texture);
+        std::unique_ptr<RoundQuestions> questions = nextQuestions.get();
+        if (decks.outdated(*questions->deck)) {
+            questions = prepareRoundQuestions(decks, replaying ? std::string() : currentPlayer, roundSeed(), questionStyle);
+        }
+        std::string roundFilter = replaying ? replay.header.deckFilter : deckFilter;
+        if (!roundFilter.empty() && !applyDeckFilter(*questions, roundFilter)) {
+            roundFilter.clear();
+        }
+        const AcronymMap& acronyms = *questions->acronyms;
+
+        // Questions follow the player's spaced-repetition schedule, or with --shuffle cycle through the whole
+        // deck; a replay restores whichever it was recorded with
+        QuestionScheduler& scheduler = *questions->scheduler;
+        bool shuffled = replaying ? replay.header.shuffled : options.shuffleDeck;
+        bool scheduled = replaying ? replay.header.spacedRepetition : !shuffled;
+        if (replaying) {
+            scheduler.restore(replay.header.reviewStep, replay.header.schedule);
         }
 
-        // Create spaceship sprite with a random texture
-        sf::Sprite spaceshipSprite(spaceshipTextures[rand() % spaceshipTextures.size()]);
-
-        // Scale the spaceship down
-        spaceshipSprite.setScale(0.5f, 0.5f); // Scale down to 50% of its original size
-
-        // Set initial spaceship position with random horizontal position at the top
-        spaceshipSprite.setPosition(rand() % (window.getSize().x - static_cast<int>(spaceshipSprite.getGlobalBounds().width * 0.5f)), 0); // Adjust for scale
-
-        sf::Font font;
-        if (!font.loadFromFile("Fonts/arial.ttf")) {
-            std::cerr << "Error loading font\n";
+        // The round starts as soon as its assets are on the GPU; usually they finished loading while the
+        // title screen was up
+        if (!waitForAssets(window, assets, roundAssets)) {
+            if (!window.isOpen()) {
+                break;
+            }
             return -1;
         }
 
-        // Variables for user input
-        std::string userInput;
-        sf::Text userInputText("", font, 24);
-        userInputText.setFillColor(sf::Color::White);
-        userInputText.setPosition(50, 550);
-
-        // Text for displaying full name of the acronym
-        sf::Text fullNameText("", font, 24);
-        fullNameText.setFillColor(sf::Color::White);
-        fullNameText.setPosition(50, 520); // Position above the user input area
+        const sf::Texture& backgroundTexture = *assets.texture(backgroundFile);
 
-        // Create a rectangle for the combined text background for the full name and user input
-        sf::RectangleShape combinedBox(sf::Vector2f(700, 120)); // Set size for the combined box
-        combinedBox.setFillColor(sf::Color(0, 0, 0, 150)); // Semi-transparent black
-        combinedBox.setPosition(40, 480); // Position above the user's input area
-
-        // Text for feedback messages
-        sf::Text feedbackText("", font, 24);
-        feedbackText.setFillColor(sf::Color::Green);
-        feedbackText.setPosition(50, 485); // Position inside feedback box
-
-        // Initial variables for game logic
-        int score = 0;
-        std::string currentAcronym = "";
-        bool acronymHit = false;
-
-        // Timer variables
-        int timer = 30; // Start the timer at 30 seconds
-        sf::Text timerText("Time: 30", font, 24);
-        timerText.setFillColor(sf::Color::White);
-        timerText.setPosition(50, 10); // Position at the top left
-
-        // Score display
-        sf::Text scoreText("Score: 0", font, 24);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition(650, 10); // Position at the top right
+        // Spaceship textures; the simulation picks which one is shown
+        std::vector<const sf::Texture*> spaceshipTextures;
+        for (const std::string& file : spaceshipFiles()) {
+            spaceshipTextures.push_back(assets.texture(file));
+        }
 
-        // Seed the random number generator
-        std::srand(static_cast<unsigned int>(std::time(0)));
+        // Spaceship sizes at the drawn scale, used by the simulation for placement and collisions
+        std::vector<sf::Vector2f> spaceshipSizes;
+        for (const sf::Texture* texture : spaceshipTextures) {
+            spaceshipSizes.emplace_back(texture->getSize().x * spaceshipScale, texture->getSize().y * spaceshipScale);
+        }
 
-        // Select a random acronym at the start
-        int randomIndex = rand() % acronyms.size();
-        auto it = acronyms.begin();
-        std::advance(it, randomIndex);
-        currentAcronym = it->first;
+        const sf::Font& font = *assets.font(gameFontFile);
 
-        if (gameMode == 1) {
-            fullNameText.setString(it->second); // Update full name for the classic mode
+        // The font is measured on this thread, which owns the window's GL context between rounds. The
+        // first round's questions were prepared before that, so they are laid out here; later rounds
+        // get theirs from the background.
+        if (!questionStyle) {
+            questionStyle = std::make_shared<const TextWrapStyle>(questionWrapStyle(font));
         }
-        else if (gameMode == 2) {
-            fullNameText.setString(it->first);  // Display the acronym in the new mode
+        if (!questions->questionLayouts) {
+            questions->questionLayouts = layoutDeck(questions->deck->library.acronyms, *questionStyle);
         }
-        else if (gameMode == 3) {
-            fullNameText.setString(it->second); // Update full name for the challenge mode
-        }
-
-        // Main game loop
-        sf::Clock clock; // Create a clock to track time
-        sf::Clock spaceshipClock; // Create a clock for spaceship movement
-        bool gameOver = false; // Flag for game over state
 
+        // The spaceship, the HUD texts and their panel
+        RoundScene scene(font, &backgroundTexture, spaceshipTextures, background, particles, questions->questionLayouts.get());
 
-        while (window.isOpen() && !gameOver) {
-            sf::Event event;
-            while (window.pollEvent(event)) {
-                if (event.type == sf::Event::Closed)
-                    window.close();
+        // Set up the round and select a random acronym at the start
+        unsigned int seed = questions->seed;
+        std::unique_ptr<ShuffledDeck> shuffledDeck;
+        if (shuffled) {
+            shuffledDeck = std::make_unique<ShuffledDeck>(acronyms, seed);
+        }
+        GameState game;
+        startGame(game, gameMode, acronyms, spaceshipSizes, layoutSize, seed,
+            scheduled ? &scheduler : nullptr, shuffledDeck.get());
+
+        // Record the round so it can be played back exactly with --replay
+        ReplayHeader replayHeader;
+        replayHeader.seed = seed;
+        replayHeader.gameMode = gameMode;
+        replayHeader.deckHash = hashDeck(acronyms, questions->weights());
+        replayHeader.spacedRepetition = scheduled;
+        replayHeader.reviewStep = scheduler.reviewStep();
+        replayHeader.schedule = scheduler.answeredCards();
+        replayHeader.shuffled = shuffled;
+        replayHeader.deckFilter = roundFilter;
+        replayHeader.streamBudget = decks.streaming ? decks.streaming->budget() : 0;
+        ReplayRecorder recorder;
+        recorder.begin(replayHeader);
+        if (replaying && replayHeader.deckHash != replay.header.deckHash) {
+            std::cerr << "Warning: The deck differs from the one the replay was recorded with, playback will diverge\n";
+        }
 
-                // Handle typing input
-                if (event.type == sf::Event::TextEntered) {
-                    if (event.text.unicode == 8) { // Handle backspace
-                        if (!userInput.empty())
-                            userInput.pop_back();
+        // The gameplay loop runs on three threads so a slow window.display() never holds up input:
+        //  - this thread polls window events and queues typed characters,
+        //  - the simulation thread applies the input and advances the timer and spaceship,
+        //  - the render thread draws the newest snapshot and presents it.
+        SpscQueue<InputEvent> inputQueue(1024);
+        TripleBuffer<FrameSnapshot> snapshots;
+        std::atomic<bool> stopRequested(false);   // Set when the window is closed mid-round
+        std::atomic<bool> simulationDone(false);  // Set by the simulation thread when the round ends
+        std::atomic<bool> windowResized(false);   // Set by this thread, the render thread applies the new view
+
+        // Latency tracking: input-to-state is owned by the simulation thread and input-to-display
+        // by the render thread until they are joined. Applied inputs are handed to the render
+        // thread so it can match them to the first displayed frame that reflects them.
+        SpscQueue<InputEvent> appliedInputQueue(1024);
+        LatencyHistogram inputToStateLatency;
+        LatencyHistogram inputToDisplayLatency;
+
+        // Heap allocations of the render thread's frames, in debug builds (AllocationCounter.h)
+        std::uint64_t lastFrameAllocations = 0;
+        std::size_t renderedFrames = 0;
+        std::size_t allocatingFrames = 0;
+
+        writeSnapshot(game, snapshots.writeBuffer());
+        snapshots.publish();
+
+        // Rolling frame statistics, toggled with F3 (F4 dumps a Chrome trace)
+        ProfilerOverlay profilerOverlay(font);
+        profilerOverlay.setFooterSource([&inputToDisplayLatency, &lastFrameAllocations]() {
+            std::string footer = "Input-to-display: " + formatLatencySummary(inputToDisplayLatency.summary());
+            if (allocationCountingEnabled) {
+                footer += "\nHeap allocations last frame: " + std::to_string(lastFrameAllocations);
+            }
+            return footer;
+        });
+
+        std::thread simulationThread([&]() {
+            setProfilerThreadName("Simulation");
+            sf::Clock stepClock;
+            std::int64_t pendingMicros = 0; // Sub-millisecond remainder carried to the next step
+            std::size_t nextReplayEvent = 0;
+            while (!stopRequested && !game.gameOver && !game.quitRequested) {
+                {
+                    PROFILE_SCOPE("simulation.input");
+                    InputEvent input;
+                    while (inputQueue.pop(input)) {
+                        handleTextEntered(game, acronyms, input.unicode);
+                        recorder.record(game.elapsedMillis, input.unicode);
+                        game.lastInputSequence = input.sequence;
+                        inputToStateLatency.record(steadyMicros() - input.timestampMicros);
+                        appliedInputQueue.push(input); // If the render thread falls behind the sample is dropped
                     }
-                    else if (event.text.unicode == 13) { // Handle enter (check input)
-                        std::transform(userInput.begin(), userInput.end(), userInput.begin(), ::toupper);
-
-                        if (gameMode == 1) {
-                            // Check if the input matches any acronym
-                            if (acronyms.find(userInput) != acronyms.end()) {
-                                // If a hit, display full name and increment score
-                                feedbackText.setString("Hit!");
-                                score += 100; // Increment score by 100
-                                timer += 5; // Add 5 seconds to the timer
-
-                                // Set random spaceship position after a hit
-                                spaceshipSprite.setPosition(rand() % (window.getSize().x - static_cast<int>(spaceshipSprite.getGlobalBounds().width)), 0); // Random position
-
-                                // Select a random spaceship texture
-                                int randomTextureIndex = rand() % spaceshipTextures.size();
-                                spaceshipSprite.setTexture(spaceshipTextures[randomTextureIndex]); // Set the new texture for the spaceship
-
-                                // Select a new random acronym for next round
-                                randomIndex = rand() % acronyms.size();
-                                it = acronyms.begin();
-                                std::advance(it, randomIndex);
-                                currentAcronym = it->first;
-                                fullNameText.setString(it->second); // Update full name for the new acronym
-                            }
-
-                            else if (userInput == "Q") {
-                                std::cout << "Quitting the game.\n";
-                                window.close();
-                            }
-
-                            else {
-                                // Missed attempt; display a missed message
-                                feedbackText.setString("Missed!");
-                                score -= 100; // Deduct 100 points
-                                // Move the spaceship down slightly
-                                spaceshipSprite.move(0, 45); // Move down 45 pixels
-                            }
-                        }
-
-                        else if (gameMode == 2) {
-                            // New Mode: Check if input matches the full name of the current acronym
-                            std::string fullName = it->second;
-                            std::transform(fullName.begin(), fullName.end(), fullName.begin(), ::toupper);
-
-                            if (userInput == fullName) {
-                                // If a hit, display full name and increment score
-                                feedbackText.setString("Hit!");
-                                score += 100; // Increment score by 100
-                                timer += 5; // Add 5 seconds to the timer
-
-                                // Set random spaceship position after a hit
-                                spaceshipSprite.setPosition(rand() % (window.getSize().x - static_cast<int>(spaceshipSprite.getGlobalBounds().width)), 0); // Random position
-
-                                // Select a random spaceship texture
-                                int randomTextureIndex = rand() % spaceshipTextures.size();
-                                spaceshipSprite.setTexture(spaceshipTextures[randomTextureIndex]); // Set the new texture for the spaceship
-
-                                // Select a new random acronym for next round
-                                randomIndex = rand() % acronyms.size();
-                                it = acronyms.begin();
-                                std::advance(it, randomIndex);
-                                currentAcronym = it->first;
-                                fullNameText.setString(it->first); // Update full name for the new acronym
-                            }
-                        
-                            else if (userInput == "Q") {
-                                std::cout << "Quitting the game.\n";
-                                window.close();
-                            }
-
-                            else {
-                                // Missed attempt; display a missed message
-                                feedbackText.setString("Incorrect! Try again.");
-                                score -= 100; // Deduct 100 points
-                                spaceshipSprite.move(0, 45); // Move down 45 pixels
-                            }
-                        }
-
-                        if (gameMode == 3) {
-                            // Check if the input matches any acronym
-                            if (acronyms.find(userInput) != acronyms.end()) {
-                                // If a hit, display full name and increment score
-                                feedbackText.setString("Hit!");
-                                score += 100; // Increment score by 100
-                                timer += 5; // Add 5 seconds to the timer
-
-                                // Set random spaceship position after a hit
-                                spaceshipSprite.setPosition(rand() % (window.getSize().x - static_cast<int>(spaceshipSprite.getGlobalBounds().width)), 0); // Random position
-
-                                // Select a random spaceship texture
-                                int randomTextureIndex = rand() % spaceshipTextures.size();
-                                spaceshipSprite.setTexture(spaceshipTextures[randomTextureIndex]); // Set the new texture for the spaceship
-
-                                // Select a new random acronym for next round
-                                randomIndex = rand() % acronyms.size();
-                                it = acronyms.begin();
-                                std::advance(it, randomIndex);
-                                currentAcronym = it->first;
-                                fullNameText.setString(it->second); // Update full name for the new acronym
-                            }
-
-                            else if (userInput == "Q") {
-                                std::cout << "Quitting the game.\n";
-                                window.close();
-                            }
-
-                            else {
-                                // Missed attempt; display a missed message
-                                feedbackText.setString("Missed!");
-                                score -= 100; // Deduct 100 points
-                                // Move the spaceship down slightly
-                                spaceshipSprite.move(0, 45); // Move down 45 pixels
-                            }
-                        }
-
+                }
 
-                            // Clear input for next round
-                            userInput.clear();
-                        }
+                {
+                    PROFILE_SCOPE("simulation.update"); // Timer and spaceship update
+                    pendingMicros += stepClock.restart().asMicroseconds();
+                    std::int64_t elapsedMillis = pendingMicros / 1000;
+                    pendingMicros -= elapsedMillis * 1000;
 
-                        else if (event.text.unicode >= 32 && event.text.unicode <= 126) {
-                            // Only handle printable characters
-                            userInput += static_cast<char>(event.text.unicode);
-                        }
+                    if (replaying) {
+                        advanceReplay(game, acronyms, replay, nextReplayEvent, elapsedMillis);
+                    }
+                    else {
+                        advanceSimulation(game, elapsedMillis);
+                    }
+                    writeSnapshot(game, snapshots.writeBuffer());
+                    snapshots.publish();
                 }
-            }
 
-            // Update the timer
-            if (clock.getElapsedTime().asSeconds() >= 1) {
-                timer--;
-                clock.restart(); // Reset the clock
+                sf::sleep(sf::milliseconds(1));
             }
-
-            // Update spaceship position to fall at 1 pixel per second for gameMode 1 only
-            if (gameMode == 1) {
-                if (spaceshipClock.getElapsedTime().asSeconds() >= 1.0f / 60.0f) { // Check if enough time has passed for movement
-                    spaceshipSprite.move(0, 0.75); // Move down by 0.75 pixels
-                    spaceshipClock.restart(); // Reset the spaceship clock
+            simulationDone = true;
+        });
+
+        // The render thread takes over the window's GL context for the round
+        window.setActive(false);
+        std::thread renderThread([&]() {
+            setProfilerThreadName("Render");
+            std::deque<InputEvent> inputsAwaitingDisplay;
+            WindowBackend backend(window);
+            sf::Clock frameClock;
+            window.setActive(true);
+            while (!stopRequested) {
+                snapshots.update();
+                const FrameSnapshot& frame = snapshots.readBuffer();
+                scene.update(frame, (std::min)(frameClock.restart().asSeconds(), 0.1f)); // A stall does not fling the particles
+
+                // Rendering logic
+                if (windowResized.exchange(false)) {
+                    backend.setView(letterboxView(window.getSize()));
                 }
-            }
+                backend.clear();
+                scene.draw(backend);
 
-            if (gameMode == 3) {
-                if (spaceshipClock.getElapsedTime().asSeconds() >= 1.0f / 60.0f) { // Check if enough time has passed for movement
-                    spaceshipSprite.move(0, 1.75); // Move down by 1.75 pixels
-                    spaceshipClock.restart(); // Reset the spaceship clock
+                {
+                    PROFILE_SCOPE("draw.profiler");
+                    profilerOverlay.draw(window);
                 }
-            }
-
-            // If the timer reaches 0 or the spaceship touches the combined box, end the game
-            if (timer <= 0 || (spaceshipSprite.getPosition().y + spaceshipSprite.getGlobalBounds().height >= window.getSize().y)) {
-                feedbackText.setString("Game Over! Final Score: " + std::to_string(score));
-                userInputText.setString(""); // Clear input
-                gameOver = true; // Set game over flag
-            }
-
-            // Update the timer and score display
-            timerText.setString("Time: " + std::to_string(timer));
-            scoreText.setString("Score: " + std::to_string(score));
 
-            // Rendering logic
-            window.clear();
-
-            // Draw the background
-            window.draw(backgroundSprite);
+                {
+                    PROFILE_SCOPE("window.display");
+                    backend.display();
+                }
 
-            // Draw the spaceship
-            window.draw(spaceshipSprite);
+                // Every applied input up to the snapshot's sequence is now visible on screen
+                std::int64_t displayedMicros = steadyMicros();
+                InputEvent applied;
+                while (appliedInputQueue.pop(applied)) {
+                    inputsAwaitingDisplay.push_back(applied);
+                }
+                while (!inputsAwaitingDisplay.empty() && inputsAwaitingDisplay.front().sequence <= frame.lastInputSequence) {
+                    inputToDisplayLatency.record(displayedMicros - inputsAwaitingDisplay.front().timestampMicros);
+                    inputsAwaitingDisplay.pop_front();
+                }
 
-            // Draw the feedback text
-            window.draw(feedbackText);
+                lastFrameAllocations = backend.frameAllocations();
+                renderedFrames++;
+                if (lastFrameAllocations > 0) {
+                    allocatingFrames++;
+                }
 
-            // Draw the combined text background
-            window.draw(combinedBox);
+                // Stop once the last frame of the round has been shown
+                if (frame.gameOver || frame.quitRequested)
+                    break;
+            }
+            window.setActive(false);
+        });
+
+        // Input loop: forward typed characters to the simulation until the round ends
+        setProfilerThreadName("Main");
+        std::uint64_t inputSequence = 0;
+        while (!simulationDone) {
+            {
+                PROFILE_SCOPE("pollEvent");
+                sf::Event event;
+                while (window.pollEvent(event)) {
+                    if (event.type == sf::Event::Closed)
+                        stopRequested = true;
+                    if (event.type == sf::Event::Resized)
+                        windowResized = true;
+
+                    handleProfilerHotkeys(event);
+
+                    if (event.type == sf::Event::TextEntered && !replaying) {
+                        InputEvent input;
+                        input.unicode = event.text.unicode;
+                        input.sequence = ++inputSequence;
+                        input.timestampMicros = steadyMicros();
+                        while (!inputQueue.push(input) && !simulationDone) {
+                            sf::sleep(sf::milliseconds(1)); // Queue full, let the simulation catch up
+                        }
+                    }
+                }
+            }
+            sf::sleep(sf::milliseconds(1));
+        }
 
-            // Draw the full name of the acronym (if hit or missed)
-            window.draw(fullNameText);
+        simulationThread.join();
+        renderThread.join();
+        window.setActive(true);
 
-            // Draw the user's input
-            userInputText.setString("Input: (Press 'q' to Quit) " + userInput);
-            window.draw(userInputText);
+        LatencySummary displayLatency = inputToDisplayLatency.summary();
+        std::cout << "Input-to-state latency: " << formatLatencySummary(inputToStateLatency.summary()) << "\n";
+        std::cout << "Input-to-display latency: " << formatLatencySummary(displayLatency) << "\n";
+        if (allocationCountingEnabled) {
+            std::cout << "Render thread: " << allocatingFrames << " of " << renderedFrames << " frames allocated\n";
+        }
 
-            // Draw the timer and score
-            window.draw(timerText);
-            window.draw(scoreText);
+        if (game.quitRequested) {
+            std::cout << "Quitting the game.\n";
+        }
+        if (stopRequested || game.quitRequested) {
+            window.close();
+        }
 
-            window.display();
+        if (replaying) {
+            std::cout << "Replay finished: score " << game.score << ", timer " << game.timer << "\n";
+            window.close();
+            break;
         }
 
-        // Replay prompt display
-        sf::Text replayText("Play again? (Y/N)", font, 24);
-        replayText.setFillColor(sf::Color::White);
-        replayText.setPosition(500, 340); // Position in the middle of the window, below the final score
+        // Keep the round for later playback
+        std::filesystem::create_directories("Replays");
+        std::string replayFile = "Replays/replay_" + std::to_string(seed) + ".air";
+        if (recorder.save(replayFile)) {
+            std::cout << "Saved replay " << replayFile << " (" << recorder.sizeInBytes() << " bytes)\n";
+        }
 
-        // Text for displaying final score
-        sf::Text finalScoreText("", font, 24);
-        finalScoreText.setFillColor(sf::Color::White);
-        finalScoreText.setPosition(500, 300); // Position above the replay prompt
+        bool gameOver = game.gameOver; // Flag for game over state
+        int score = game.score;
+        // The leaderboard and replay prompt shown once the score is saved
+        LeaderboardScene leaderboard(font);
 
         // Show the replay prompt
+        WindowBackend backend(window);
         while (gameOver && window.isOpen()) {
             bool scoreSaved = false; // Track if the score has already been saved
-            std::string playerName;  // Store the player's name
+            std::vector<std::pair<std::string, int>> topScores; // Fetched once the score is saved
+            std::string playerName = currentPlayer; // Store the player's name, the last one is offered again
             sf::Text namePrompt("Enter your name: ", font, 24);
             namePrompt.setFillColor(sf::Color::White);
             namePrompt.setPosition(200, 200);
 
-            sf::Text nameInput("", font, 24); // Text to display the name being entered
+            sf::Text nameInput(playerName, font, 24); // Text to display the name being entered
             nameInput.setFillColor(sf::Color::White);
             nameInput.setPosition(200, 250);
 
@@ -632,6 +954,9 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 while (window.pollEvent(event)) {
                     if (event.type == sf::Event::Closed)
                         window.close();
+                    handleResizeEvent(window, event);
+
+                    handleProfilerHotkeys(event);
 
                     if (!scoreSaved) {
                         // Handle name input
@@ -642,14 +967,20 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                             }
                             else if (event.text.unicode == 13) { // Handle Enter (complete input)
                                 if (!playerName.empty()) {
-                                    insertScore(playerName, score); // Save the score
+                                    insertScore(playerName, score, displayLatency); // Save the score
                                     scoreSaved = true; // Mark score as saved
                                 }
                                 else {
                                     playerName = "Anonymous"; // Default name
-                                    insertScore(playerName, score); // Save the score
+                                    insertScore(playerName, score, displayLatency); // Save the score
                                     scoreSaved = true;
                                 }
+                                topScores = getTopScores(); // Fetch the top scores, including this one
+                                saveRoundSchedule(scheduler, currentPlayer, playerName, acronyms, questions->weights());
+                                currentPlayer = playerName;
+
+                                // Get the next round's questions ready while the leaderboard is up
+                                nextQuestions = std::async(std::launch::async, prepareRoundQuestions, std::ref(decks), currentPlayer, roundSeed(), questionStyle);
                             }
                             else if (event.text.unicode >= 32 && event.text.unicode <= 126) {
                                 playerName += static_cast<char>(event.text.unicode); // Add character
@@ -663,10 +994,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                             if (event.text.unicode == 'Y' || event.text.unicode == 'y') {
                                 playAgain = true; // Restart the game
                                 gameOver = false; // Reset game over state
-                                score = 0; // Reset score
-                                timer = 30; // Reset timer
-                                feedbackText.setString(""); // Clear feedback text
-                                userInput.clear(); // Clear user input
                             }
                             else if (event.text.unicode == 'N' || event.text.unicode == 'n') {
                                 playAgain = false; // Exit the game loop
@@ -677,25 +1004,39 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 }
 
                 // Render the game over UI
-                window.clear();
-                window.draw(backgroundSprite);
+                backend.clear();
+                background.draw(backend, &backgroundTexture);
 
                 if (!scoreSaved) {
-                    window.draw(namePrompt);
-                    window.draw(nameInput);
+                    backend.draw(namePrompt);
+                    backend.draw(nameInput);
                 }
                 else {
-                    auto topScores = getTopScores(); // Fetch the top scores
-                    displayHighScores(window, font, topScores); // Display high scores on the screen
-                    window.draw(finalScoreText); // Draw the final score text
-                    window.draw(replayText); // Draw replay text
+                    leaderboard.draw(backend, topScores);
                 }
 
-                window.display();
+                profilerOverlay.draw(window);
+
+                {
+                    PROFILE_SCOPE("window.display");
+                    backend.display();
+                }
             }
 
         }
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+#ifdef _WIN32
+// Entry point for Windows applications
+int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd) {
+    return runGame(__argc, __argv);
+}
+#else
+// Entry point elsewhere, e.g. for --headless runs on build machines without a display
+int main(int argc, char** argv) {
+    return runGame(argc, argv);
+}
+#endif
\ No newline at end of file
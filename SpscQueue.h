@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded single-producer/single-consumer queue.
+// One thread may call push() and one other thread may call pop(); neither ever blocks.
+template <typename T>
+class SpscQueue {
+public:
+    // Capacity is rounded up to a power of two so indices can be masked instead of divided
+    explicit SpscQueue(std::size_t capacity = 256) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side: returns false if the queue is full
+    bool push(const T& value) {
+        const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headIndex.load(std::memory_order_acquire) > mask) {
+            return false;
+        }
+        slots[tail & mask] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: returns false if there is nothing to read
+    bool pop(T& value) {
+        const std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots[head & mask];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask = 0;
+    alignas(64) std::atomic<std::size_t> headIndex{ 0 }; // Written by the consumer only
+    alignas(64) std::atomic<std::size_t> tailIndex{ 0 }; // Written by the producer only
+};
@@ -0,0 +1,226 @@
+#include "StreamingDeck.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <unordered_set>
+
+namespace {
+    // Bytes read from the file at a time while scanning
+    const std::size_t scanChunk = 1 << 20;
+
+    // Memory a round deck needs per card besides the text of its line: map nodes, string headers
+    // and the scheduler's per-card state
+    const std::size_t cardOverhead = 160;
+
+    // Memory a cached line needs besides its text: the list and index nodes
+    const std::size_t cacheOverhead = 96;
+}
+
+StreamingDeck::StreamingDeck(const std::string& filename, std::size_t memoryBudget, std::uint64_t seed)
+    : filename(filename), file(filename, std::ios::binary), memoryBudget(memoryBudget), stopping(false) {
+    cacheBudget = memoryBudget / 4;
+    scanned = std::async(std::launch::async, &StreamingDeck::scan, this, seed);
+}
+
+StreamingDeck::~StreamingDeck() {
+    stopping = true;
+    scanned.wait();
+}
+
+void StreamingDeck::scan(std::uint64_t seed) {
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream input(filename, std::ios::binary);
+    if (!input) {
+        std::cerr << "Error: Unable to open file: " << filename << std::endl;
+        return;
+    }
+
+    // Half the budget holds the sample; a small file can hold no more lines than it has bytes for
+    std::size_t capacity = std::max<std::size_t>(1, std::min<std::size_t>(memoryBudget / 2 / sizeof(SampledLine), 0xFFFFFFFFu));
+    std::error_code error;
+    std::uintmax_t fileSize = std::filesystem::file_size(filename, error);
+    if (!error) {
+        capacity = std::min<std::size_t>(capacity, static_cast<std::size_t>(fileSize / 2 + 1));
+    }
+    sample.reserve(capacity);
+
+    // Algorithm L: after the reservoir is full, skip ahead a geometric number of lines to the next
+    // one that replaces a random slot, instead of drawing a random number for every line
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto random = [&]() { return 1.0 - unit(rng); }; // (0, 1], so the logarithm is finite
+    double w = std::exp(std::log(random()) / static_cast<double>(capacity));
+    auto skip = [&]() { return static_cast<std::uint64_t>(std::floor(std::log(random()) / std::log1p(-w))); };
+    std::uint64_t nextReplace = capacity + skip();
+
+    std::uint64_t lineBytes = 0;
+    auto addLine = [&](std::uint64_t offset, std::uint64_t length) {
+        if (length > 0xFFFFFFFFu) {
+            return;
+        }
+        if (linesSeen < capacity) {
+            sample.push_back({ offset, static_cast<std::uint32_t>(length) });
+        }
+        else if (linesSeen == nextReplace) {
+            sample[rng() % capacity] = { offset, static_cast<std::uint32_t>(length) };
+            w *= std::exp(std::log(random()) / static_cast<double>(capacity));
+            nextReplace += skip() + 1;
+        }
+        linesSeen++;
+        lineBytes += length;
+    };
+
+    // Only lines with a comma can be acronyms; a line may span two chunks
+    std::vector<char> buffer(scanChunk);
+    std::uint64_t chunkOffset = 0;
+    std::uint64_t lineStart = 0;
+    bool lineHasComma = false;
+    while (!stopping && input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::size_t count = static_cast<std::size_t>(input.gcount());
+        const char* position = buffer.data();
+        const char* end = position + count;
+        while (const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position))) {
+            if (lineHasComma || std::memchr(position, ',', newline - position)) {
+                std::uint64_t lineEnd = chunkOffset + (newline - buffer.data());
+                addLine(lineStart, lineEnd - lineStart);
+            }
+            lineStart = chunkOffset + (newline - buffer.data()) + 1;
+            lineHasComma = false;
+            position = newline + 1;
+        }
+        lineHasComma = lineHasComma || std::memchr(position, ',', end - position) != nullptr;
+        chunkOffset += count;
+    }
+    if (lineHasComma && lineStart < chunkOffset) {
+        addLine(lineStart, chunkOffset - lineStart); // Last line without a newline
+    }
+
+    // A quarter of the budget holds the round deck
+    if (!sample.empty()) {
+        std::size_t cardBytes = static_cast<std::size_t>(lineBytes / linesSeen) + cardOverhead;
+        roundCards = std::max<std::size_t>(1, std::min({ sample.size(), maxRoundCards, memoryBudget / 4 / cardBytes }));
+    }
+    scanTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Sampled " << sample.size() << " of " << linesSeen << " acronyms from " << filename << " in "
+        << static_cast<long long>(scanTime) << "ms, " << roundCards << " per round\n";
+}
+
+const AcronymEntry* StreamingDeck::fetch(std::uint32_t slot) {
+    auto cached = cacheSlots.find(slot);
+    if (cached != cacheSlots.end()) {
+        hits++;
+        cache.splice(cache.begin(), cache, cached->second);
+        return &cached->second->entry;
+    }
+    misses++;
+
+    const SampledLine& line = sample[slot];
+    std::string text(line.length, '\0');
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(line.offset));
+    if (!file.read(&text[0], line.length)) {
+        std::cerr << "Error: Unable to read " << filename << " at byte " << line.offset << std::endl;
+        return nullptr;
+    }
+
+    CachedLine entry;
+    entry.slot = slot;
+    if (!parseAcronymLine(text, entry.entry)) {
+        return nullptr;
+    }
+    entry.bytes = sizeof(CachedLine) + cacheOverhead + entry.entry.acronym.capacity() + entry.entry.fullName.capacity();
+    for (const std::string& tag : entry.entry.tags) {
+        entry.bytes += sizeof(std::string) + tag.capacity();
+    }
+
+    // Evict the least recently used lines, always keeping the one just read
+    cachedBytes += entry.bytes;
+    cache.push_front(std::move(entry));
+    cacheSlots[slot] = cache.begin();
+    while (cachedBytes > cacheBudget && cache.size() > 1) {
+        cachedBytes -= cache.back().bytes;
+        cacheSlots.erase(cache.back().slot);
+        cache.pop_back();
+    }
+    return &cache.front().entry;
+}
+
+std::shared_ptr<DeckSnapshot> StreamingDeck::drawRound(std::uint64_t roundSeed) {
+    scanned.wait();
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (sample.empty()) {
+        return nullptr;
+    }
+
+    // Floyd's algorithm picks roundCards distinct slots without touching the others
+    std::vector<std::uint32_t> slots;
+    std::uint32_t total = static_cast<std::uint32_t>(sample.size());
+    if (roundCards >= sample.size()) {
+        slots.resize(total);
+        for (std::uint32_t slot = 0; slot < total; ++slot) {
+            slots[slot] = slot;
+        }
+    }
+    else {
+        std::mt19937_64 rng(roundSeed);
+        std::unordered_set<std::uint32_t> chosen;
+        chosen.reserve(roundCards);
+        for (std::uint32_t j = total - static_cast<std::uint32_t>(roundCards); j < total; ++j) {
+            std::uint32_t slot = static_cast<std::uint32_t>(rng() % (static_cast<std::uint64_t>(j) + 1));
+            if (!chosen.insert(slot).second) {
+                chosen.insert(j);
+            }
+        }
+        slots.assign(chosen.begin(), chosen.end());
+    }
+
+    // In file order, so reads go forward and a later line replaces an earlier one like in loadAcronyms
+    std::sort(slots.begin(), slots.end(), [this](std::uint32_t a, std::uint32_t b) { return sample[a].offset < sample[b].offset; });
+
+    auto start = std::chrono::steady_clock::now();
+    auto deck = std::make_shared<DeckSnapshot>();
+    DeckLibrary& library = deck->library;
+    library.acronyms.reserve(slots.size());
+    for (std::uint32_t slot : slots) {
+        const AcronymEntry* entry = fetch(slot);
+        if (!entry) {
+            continue;
+        }
+        if (entry->tagged) {
+            library.tags[entry->acronym] = entry->tags;
+        }
+        else {
+            library.tags.erase(entry->acronym);
+        }
+        if (entry->weighted) {
+            library.weights[entry->acronym] = entry->weight;
+        }
+        else {
+            library.weights.erase(entry->acronym);
+        }
+        library.acronyms[entry->acronym] = entry->fullName;
+    }
+
+    DeckSource source;
+    source.file = filename;
+    source.parsed = slots.size();
+    source.used = library.acronyms.size();
+    source.parseMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    library.decks.push_back(source);
+    library.loadMillis = source.parseMillis;
+    library.deckCards.resize(1);
+    for (const auto& entry : library.acronyms) {
+        library.deckCards[0].push_back(&entry.first);
+    }
+    std::sort(library.deckCards[0].begin(), library.deckCards[0].end(),
+        [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    deck->tagIndex = std::make_unique<TagIndex>(library.acronyms, library.tags);
+    deck->generation = 1;
+    return deck;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Acronyms.h"
+#include "DeckWatcher.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Plays from a deck file too large to load, keeping memory within a fixed budget.
+//
+// A background thread streams through the file once and keeps a uniform reservoir sample of its
+// lines (Algorithm L), remembering only where each sampled line starts and how long it is. Each
+// round then draws a random subset of the sample and reads those lines back from the file, through
+// an LRU cache of parsed lines, into an ordinary in-memory deck. All file access happens in drawRound(), which the
+// game calls while preparing the next round in the background, so the simulation and render threads
+// only ever see a small, fully loaded deck.
+//
+// The budget is split between the sample (half), the line cache (a quarter) and the round deck (a
+// quarter). It bounds the deck data, not the whole process. Duplicate acronyms are only resolved
+// within a round, the later line winning as it does in loadAcronyms.
+class StreamingDeck {
+public:
+    // Most cards a round deck holds however large the budget is; a round asks far fewer questions
+    static constexpr std::size_t maxRoundCards = 1 << 16;
+
+    // Function to start sampling a deck file, keeping the deck data within memoryBudget bytes
+    StreamingDeck(const std::string& filename, std::size_t memoryBudget, std::uint64_t seed = 0x5EED);
+    ~StreamingDeck();
+
+    StreamingDeck(const StreamingDeck&) = delete;
+    StreamingDeck& operator=(const StreamingDeck&) = delete;
+
+    // Function to read a random round deck from the sample, waiting for the scan to finish; returns
+    // nullptr if the file has no acronyms. The sample only depends on the file, the budget and the
+    // scan seed, so the same file, budget and round seed always give the same deck.
+    std::shared_ptr<DeckSnapshot> drawRound(std::uint64_t roundSeed);
+
+    std::size_t budget() const { return memoryBudget; }
+
+    // Statistics, valid once the first drawRound() has returned
+    std::uint64_t lineCount() const { return linesSeen; }     // Acronym lines in the whole file
+    std::size_t sampleSize() const { return sample.size(); }
+    std::size_t roundSize() const { return roundCards; }
+    double scanMillis() const { return scanTime; }
+    std::uint64_t cacheHits() const { return hits; }
+    std::uint64_t cacheMisses() const { return misses; }
+    std::size_t cacheBytes() const { return cachedBytes; }
+
+private:
+    // Where one sampled line is in the file
+    struct SampledLine {
+        std::uint64_t offset;
+        std::uint32_t length;
+    };
+
+    struct CachedLine {
+        std::uint32_t slot;
+        AcronymEntry entry;
+        std::size_t bytes;
+    };
+
+    void scan(std::uint64_t seed);
+    const AcronymEntry* fetch(std::uint32_t slot);
+
+    std::string filename;
+    std::ifstream file;
+    std::size_t memoryBudget;
+    std::vector<SampledLine> sample;
+    std::uint64_t linesSeen = 0;
+    std::size_t roundCards = 0;
+    double scanTime = 0.0;
+
+    // LRU cache of parsed lines, most recently used first, keyed by sample slot. The mutex also
+    // guards the file, so rounds can be drawn from several threads.
+    std::mutex readMutex;
+    std::list<CachedLine> cache;
+    std::unordered_map<std::uint32_t, std::list<CachedLine>::iterator> cacheSlots;
+    std::size_t cachedBytes = 0;
+    std::size_t cacheBudget = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+
+    // Declared last so the scan is stopped and joined before anything it uses is destroyed
+    std::atomic<bool> stopping;
+    std::shared_future<void> scanned;
+};
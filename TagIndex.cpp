@@ -0,0 +1,244 @@
+#include "TagIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <unordered_set>
+
+namespace {
+    std::string toUpper(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), ::toupper);
+        return text;
+    }
+
+    // Recursive-descent evaluation of a filter:
+    //   filter := term { OR term }
+    //   term   := factor { AND factor }
+    //   factor := { NOT } ( TAG | "(" filter ")" )
+    class FilterParser {
+    public:
+        FilterParser(const std::string& filter, const std::unordered_map<std::string, std::shared_ptr<const CardSet>>& tagSets, const CardSet& allCards)
+            : tagSets(tagSets), allCards(allCards) {
+            std::string token;
+            for (char c : filter) {
+                if (c == '(' || c == ')' || std::isspace(static_cast<unsigned char>(c))) {
+                    if (!token.empty()) {
+                        tokens.push_back(toUpper(token));
+                        token.clear();
+                    }
+                    if (c == '(' || c == ')') {
+                        tokens.push_back(std::string(1, c));
+                    }
+                }
+                else {
+                    token += c;
+                }
+            }
+            if (!token.empty()) {
+                tokens.push_back(toUpper(token));
+            }
+        }
+
+        bool parse(CardSet& cards) {
+            if (!parseFilter(cards)) {
+                return false;
+            }
+            if (position < tokens.size()) {
+                std::cerr << "Error: Unexpected '" << tokens[position] << "' in deck filter\n";
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        bool accept(const char* keyword) {
+            if (position < tokens.size() && tokens[position] == keyword) {
+                position++;
+                return true;
+            }
+            return false;
+        }
+
+        bool parseFilter(CardSet& cards) {
+            if (!parseTerm(cards)) {
+                return false;
+            }
+            while (accept("OR")) {
+                CardSet other;
+                if (!parseTerm(other)) {
+                    return false;
+                }
+                cards = cards.unite(other);
+            }
+            return true;
+        }
+
+        bool parseTerm(CardSet& cards) {
+            bool negated = false;
+            if (!parseFactor(cards, negated)) {
+                return false;
+            }
+            if (negated) {
+                cards = allCards.subtract(cards);
+            }
+            while (accept("AND")) {
+                CardSet other;
+                if (!parseFactor(other, negated)) {
+                    return false;
+                }
+                cards = negated ? cards.subtract(other) : cards.intersect(other);
+            }
+            return true;
+        }
+
+        // Leading NOTs are returned in negated instead of being applied, so the caller can subtract
+        bool parseFactor(CardSet& cards, bool& negated) {
+            negated = false;
+            while (accept("NOT")) {
+                negated = !negated;
+            }
+
+            if (position >= tokens.size()) {
+                std::cerr << "Error: Deck filter ends too early\n";
+                return false;
+            }
+            if (accept("(")) {
+                if (!parseFilter(cards)) {
+                    return false;
+                }
+                if (!accept(")")) {
+                    std::cerr << "Error: Missing ')' in deck filter\n";
+                    return false;
+                }
+                return true;
+            }
+
+            const std::string& tag = tokens[position];
+            auto it = tagSets.find(tag);
+            if (it == tagSets.end()) {
+                std::cerr << "Error: Unknown tag in deck filter: " << tag << "\n";
+                return false;
+            }
+            position++;
+            cards = *it->second;
+            return true;
+        }
+
+        const std::unordered_map<std::string, std::shared_ptr<const CardSet>>& tagSets;
+        const CardSet& allCards;
+        std::vector<std::string> tokens;
+        std::size_t position = 0;
+    };
+}
+
+TagIndex::TagIndex(const AcronymMap& acronyms, const AcronymTags& tags) {
+    std::unordered_map<std::string, CardSet> building;
+    entries.reserve(acronyms.size());
+    for (const auto& entry : acronyms) {
+        std::uint32_t card = static_cast<std::uint32_t>(entries.size());
+        entries.push_back(&entry);
+
+        // Cards are visited in increasing order, so every set is built by appending
+        auto cardTags = tags.find(entry.first);
+        if (cardTags != tags.end()) {
+            for (const std::string& tag : cardTags->second) {
+                CardSet& cards = building[toUpper(tag)];
+                if (cards.empty() || !cards.contains(card)) {
+                    cards.add(card);
+                }
+            }
+        }
+    }
+    for (auto& tag : building) {
+        tagSets.emplace(tag.first, std::make_shared<const CardSet>(std::move(tag.second)));
+    }
+    allCards = CardSet::range(static_cast<std::uint32_t>(entries.size()));
+}
+
+TagIndex::TagIndex(const TagIndex& previous, const AcronymTags& previousTags, const AcronymMap& acronyms, const AcronymTags& tags,
+    const std::vector<std::string>& changed)
+    : tagSets(previous.tagSets), allCards(previous.allCards) {
+    // Changed entries are told apart by address while walking the deck, so no acronym is hashed twice
+    std::unordered_set<const AcronymMap::value_type*> changedEntries;
+    for (const std::string& acronym : changed) {
+        auto entry = acronyms.find(acronym);
+        if (entry != acronyms.end()) {
+            changedEntries.insert(&*entry);
+        }
+    }
+
+    // The changed cards, in increasing order, and every tag they had or have now
+    CardSet changedCards;
+    std::vector<std::pair<std::uint32_t, const std::vector<std::string>*>> changedTags;
+    std::unordered_set<std::string> touchedTags;
+    entries.reserve(acronyms.size());
+    for (const auto& entry : acronyms) {
+        std::uint32_t card = static_cast<std::uint32_t>(entries.size());
+        entries.push_back(&entry);
+        if (changedEntries.empty() || changedEntries.count(&entry) == 0) {
+            continue;
+        }
+        changedCards.add(card);
+
+        auto oldTags = previousTags.find(entry.first);
+        if (oldTags != previousTags.end()) {
+            for (const std::string& tag : oldTags->second) {
+                touchedTags.insert(toUpper(tag));
+            }
+        }
+        auto newTags = tags.find(entry.first);
+        if (newTags != tags.end()) {
+            changedTags.emplace_back(card, &newTags->second);
+            for (const std::string& tag : newTags->second) {
+                touchedTags.insert(toUpper(tag));
+            }
+        }
+    }
+
+    // A touched set keeps its other cards and takes the changed cards that carry the tag now
+    for (const std::string& tag : touchedTags) {
+        CardSet carriers;
+        for (const auto& card : changedTags) {
+            bool carries = std::any_of(card.second->begin(), card.second->end(),
+                [&tag](const std::string& cardTag) { return toUpper(cardTag) == tag; });
+            if (carries) {
+                carriers.add(card.first);
+            }
+        }
+
+        auto existing = tagSets.find(tag);
+        CardSet cards = existing != tagSets.end() ? existing->second->subtract(changedCards).unite(carriers) : carriers;
+        if (cards.empty()) {
+            tagSets.erase(tag);
+        }
+        else {
+            tagSets[tag] = std::make_shared<const CardSet>(std::move(cards));
+        }
+    }
+}
+
+bool TagIndex::evaluate(const std::string& filter, CardSet& cards) const {
+    FilterParser parser(filter, tagSets, allCards);
+    return parser.parse(cards);
+}
+
+AcronymMap TagIndex::subDeck(const CardSet& cards) const {
+    std::vector<std::uint32_t> selected = cards.cards();
+    AcronymMap deck;
+    deck.reserve(selected.size());
+    for (std::uint32_t card : selected) {
+        if (card < entries.size()) {
+            deck.insert(*entries[card]);
+        }
+    }
+    return deck;
+}
+
+std::vector<std::string> TagIndex::tagNames() const {
+    std::vector<std::string> names;
+    names.reserve(tagSets.size());
+    for (const auto& tag : tagSets) {
+        names.push_back(tag.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
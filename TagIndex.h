@@ -0,0 +1,45 @@
+#pragma once
+#include "Acronyms.h"
+#include "CardSet.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// The cards of a deck grouped by tag, so a round can be limited to part of the deck.
+// Cards are numbered in deck iteration order, like in QuestionScheduler.
+//
+// A filter combines tag names (case-insensitive) with NOT, AND and OR, binding in that order, and
+// parentheses, e.g. "Crypto AND NOT Wireless" or "(Network OR Wireless) AND NOT Attack".
+// "AND NOT" subtracts one set from the other directly, so it never builds the complement.
+//
+// The sets are immutable once built and shared, so an index of an edited deck can reuse every set
+// the edit did not touch (see the second constructor).
+class TagIndex {
+public:
+    // Function to build one CardSet per tag; the deck must outlive the index
+    TagIndex(const AcronymMap& acronyms, const AcronymTags& tags);
+
+    // Function to index a new version of a deck by patching the previous version's index. Both
+    // versions have to hold the same acronyms in the same iteration order, so cards keep their
+    // numbers; changed lists the acronyms whose tags may differ. Only the sets of tags those cards
+    // had or have now are rebuilt, the others are shared with the previous index.
+    TagIndex(const TagIndex& previous, const AcronymTags& previousTags, const AcronymMap& acronyms, const AcronymTags& tags,
+        const std::vector<std::string>& changed);
+
+    // Function to evaluate a filter, returns false (and says why) if it is malformed or names an unknown tag
+    bool evaluate(const std::string& filter, CardSet& cards) const;
+
+    // Function to copy the given cards into a deck of their own
+    AcronymMap subDeck(const CardSet& cards) const;
+
+    // Function to list the tags, upper-cased and sorted
+    std::vector<std::string> tagNames() const;
+
+    std::size_t size() const { return entries.size(); }
+
+private:
+    std::vector<const AcronymMap::value_type*> entries; // Card -> deck entry, in deck iteration order
+    std::unordered_map<std::string, std::shared_ptr<const CardSet>> tagSets; // Upper-cased tag -> cards carrying it
+    CardSet allCards;
+};
@@ -0,0 +1,82 @@
+#include "TextArena.h"
+#include <functional>
+#include <iostream>
+
+namespace {
+    std::size_t hashText(std::string_view text) {
+        return std::hash<std::string_view>()(text);
+    }
+}
+
+void TextArena::reserve(std::size_t bytes, std::size_t strings) {
+    text.reserve(bytes);
+    std::size_t slots = 16;
+    while (slots < strings * 2) {
+        slots *= 2;
+    }
+    if (slots > table.size()) {
+        rehash(slots);
+    }
+}
+
+bool TextArena::append(std::string_view value, TextRef& ref) {
+    if (value.size() > maxBytes - text.size()) {
+        std::cerr << "Error: Text arena is full (" << text.size() << " bytes)\n";
+        return false;
+    }
+    ref.offset = static_cast<std::uint32_t>(text.size());
+    ref.length = static_cast<std::uint32_t>(value.size());
+    text.insert(text.end(), value.begin(), value.end());
+    return true;
+}
+
+bool TextArena::intern(std::string_view value, TextRef& ref) {
+    if (value.empty()) {
+        ref = TextRef();
+        return true;
+    }
+    if ((tableCount + 1) * 2 > table.size()) {
+        rehash(table.empty() ? 16 : table.size() * 2);
+    }
+
+    // Linear probing; the table is at most half full, so a free slot is always found
+    std::size_t slot = hashText(value) & (table.size() - 1);
+    while (table[slot].offset != emptySlot) {
+        if (view(table[slot]) == value) {
+            ref = table[slot];
+            return true;
+        }
+        slot = (slot + 1) & (table.size() - 1);
+    }
+    if (!append(value, ref)) {
+        return false;
+    }
+    table[slot] = ref;
+    tableCount++;
+    return true;
+}
+
+void TextArena::rehash(std::size_t slots) {
+    std::vector<TextRef> old(slots, TextRef{ emptySlot, 0 });
+    old.swap(table);
+    for (const TextRef& ref : old) {
+        if (ref.offset == emptySlot) {
+            continue;
+        }
+        std::size_t slot = hashText(view(ref)) & (table.size() - 1);
+        while (table[slot].offset != emptySlot) {
+            slot = (slot + 1) & (table.size() - 1);
+        }
+        table[slot] = ref;
+    }
+}
+
+void TextArena::shrinkToFit() {
+    std::vector<TextRef>().swap(table);
+    tableCount = 0;
+    text.shrink_to_fit();
+}
+
+std::size_t TextArena::sizeInBytes() const {
+    return text.capacity() + table.capacity() * sizeof(TextRef);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// A string stored in a TextArena: 8 bytes, against 32 for a std::string plus its heap block once
+// the text is longer than the small-string buffer
+struct TextRef {
+    std::uint32_t offset = 0;
+    std::uint32_t length = 0;
+};
+
+// Text stored back to back in one buffer and referred to by offset and length.
+//
+// Strings are only ever appended, so storing one is a copy to the end of the buffer; reserving the
+// total size up front means the buffer is allocated once. intern() stores equal strings once,
+// through an open-addressing table of the strings stored so far. Offsets are 32 bits, so an arena
+// holds at most 4 GB of text.
+class TextArena {
+public:
+    static constexpr std::size_t maxBytes = 0xFFFFFFFF;
+
+    // Function to size the buffer for bytes of text, and the intern table for that many strings
+    void reserve(std::size_t bytes, std::size_t strings = 0);
+
+    // Function to copy text to the end of the arena; returns false if the arena is full
+    bool append(std::string_view text, TextRef& ref);
+
+    // Function to store text unless an equal string is already stored; returns false if the arena is full
+    bool intern(std::string_view text, TextRef& ref);
+
+    // Function to free the intern table and any unused capacity once nothing more is stored
+    void shrinkToFit();
+
+    std::string_view view(TextRef ref) const { return std::string_view(text.data() + ref.offset, ref.length); }
+    std::size_t size() const { return text.size(); }
+
+    // Function to report the memory held by the buffer and the intern table
+    std::size_t sizeInBytes() const;
+
+private:
+    static constexpr std::uint32_t emptySlot = 0xFFFFFFFF;
+
+    void rehash(std::size_t slots);
+
+    std::vector<char> text;
+    std::vector<TextRef> table; // Interned strings by hash; offset emptySlot marks a free slot
+    std::size_t tableCount = 0;
+};
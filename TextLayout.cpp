@@ -0,0 +1,146 @@
+#include "TextLayout.h"
+
+namespace {
+    const unsigned char firstPrintable = 32;
+    const unsigned char lastPrintable = 126;
+    const std::size_t printableCount = lastPrintable - firstPrintable + 1;
+
+    bool isPrintable(unsigned char c) {
+        return c >= firstPrintable && c <= lastPrintable;
+    }
+
+    // Function to wrap text at one size; returns the number of lines
+    std::size_t wrapText(std::string_view text, const GlyphMetrics& metrics, float width, std::string& wrapped) {
+        wrapped.clear();
+        std::size_t lineCount = 1;
+        float lineWidth = 0;
+        bool lineStarted = false;
+        unsigned char previous = 0;
+
+        // Function to start a new line
+        auto breakLine = [&]() {
+            wrapped += '\n';
+            lineCount++;
+            lineWidth = 0;
+            lineStarted = false;
+        };
+
+        std::size_t start = 0;
+        while (start < text.size()) {
+            std::size_t end = text.find(' ', start);
+            if (end == std::string_view::npos) {
+                end = text.size();
+            }
+            std::string_view word = text.substr(start, end - start);
+            start = end + 1;
+            if (word.empty()) {
+                continue; // Runs of spaces collapse into one
+            }
+
+            // Append the word to the line if it fits after a space
+            unsigned char first = static_cast<unsigned char>(word.front());
+            if (lineStarted) {
+                float joined = lineWidth + metrics.kerningBetween(previous, ' ') + metrics.advances[' '] +
+                    metrics.kerningBetween(' ', first) + metrics.measure(word);
+                if (joined <= width) {
+                    wrapped += ' ';
+                    wrapped += word;
+                    lineWidth = joined;
+                    previous = static_cast<unsigned char>(word.back());
+                    continue;
+                }
+                breakLine();
+            }
+
+            // Otherwise it starts a line, split between characters if it is wider than one
+            for (char c : word) {
+                unsigned char current = static_cast<unsigned char>(c);
+                float extended = lineWidth + (lineStarted ? metrics.kerningBetween(previous, current) : 0.0f) + metrics.advances[current];
+                if (lineStarted && extended > width) {
+                    breakLine();
+                    extended = metrics.advances[current];
+                }
+                wrapped += c;
+                lineWidth = extended;
+                lineStarted = true;
+                previous = current;
+            }
+        }
+        return lineCount;
+    }
+}
+
+float GlyphMetrics::kerningBetween(unsigned char first, unsigned char second) const {
+    if (kerning.empty() || !isPrintable(first) || !isPrintable(second)) {
+        return 0;
+    }
+    return kerning[(first - firstPrintable) * printableCount + (second - firstPrintable)];
+}
+
+float GlyphMetrics::measure(std::string_view text) const {
+    float width = 0;
+    unsigned char previous = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        unsigned char current = static_cast<unsigned char>(text[i]);
+        if (i > 0) {
+            width += kerningBetween(previous, current);
+        }
+        width += advances[current];
+        previous = current;
+    }
+    return width;
+}
+
+GlyphMetrics measureGlyphs(const sf::Font& font, unsigned characterSize) {
+    GlyphMetrics metrics;
+    metrics.characterSize = characterSize;
+    metrics.lineSpacing = font.getLineSpacing(characterSize);
+    for (unsigned c = firstPrintable; c < metrics.advances.size(); ++c) {
+        metrics.advances[c] = font.getGlyph(c, characterSize, false).advance;
+    }
+    metrics.kerning.resize(printableCount * printableCount);
+    for (std::size_t first = 0; first < printableCount; ++first) {
+        for (std::size_t second = 0; second < printableCount; ++second) {
+            metrics.kerning[first * printableCount + second] = font.getKerning(
+                static_cast<sf::Uint32>(first + firstPrintable), static_cast<sf::Uint32>(second + firstPrintable), characterSize);
+        }
+    }
+    return metrics;
+}
+
+TextLayout layoutText(std::string_view text, const TextWrapStyle& style) {
+    TextLayout layout;
+    for (const GlyphMetrics& metrics : style.sizes) {
+        layout.lineCount = wrapText(text, metrics, style.width, layout.text);
+        layout.characterSize = metrics.characterSize;
+        layout.height = layout.lineCount * metrics.lineSpacing;
+        if (layout.height <= style.height) {
+            break;
+        }
+    }
+    return layout;
+}
+
+std::shared_ptr<const DeckLayouts> layoutDeck(const AcronymMap& acronyms, const TextWrapStyle& style) {
+    auto layouts = std::make_shared<DeckLayouts>();
+    layouts->reserve(acronyms.size() * 2);
+    for (const auto& [acronym, fullName] : acronyms) {
+        if (layouts->find(fullName) == layouts->end()) {
+            layouts->emplace(fullName, layoutText(fullName, style));
+        }
+        if (layouts->find(acronym) == layouts->end()) {
+            layouts->emplace(acronym, layoutText(acronym, style));
+        }
+    }
+    return layouts;
+}
+
+void setTextLabel(sf::Text& text, sf::String& label, std::string_view prefix, std::string_view value, std::string_view suffix) {
+    label.clear();
+    for (std::string_view part : { prefix, value, suffix }) {
+        for (char c : part) {
+            label += sf::String(static_cast<sf::Uint32>(static_cast<unsigned char>(c)));
+        }
+    }
+    text.setString(label);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include "Acronyms.h"
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Glyph advances and kerning of one font at one character size.
+//
+// Measuring goes through sf::Font, which renders each glyph into a texture and is not thread-safe,
+// so it is done once on the thread that draws. The tables are plain numbers after that, and text
+// can be laid out on any thread; the widths match what sf::Text draws with default spacing.
+struct GlyphMetrics {
+    unsigned characterSize = 0;
+    float lineSpacing = 0;
+    std::array<float, 256> advances{}; // By byte, as sf::Text converts a std::string
+    std::vector<float> kerning;        // Between printable ASCII characters, see kerningBetween()
+
+    float kerningBetween(unsigned char first, unsigned char second) const;
+
+    // Function to measure the width of a single line of text
+    float measure(std::string_view text) const;
+};
+
+// Function to measure a font at a character size; call it from the thread that draws with the font
+GlyphMetrics measureGlyphs(const sf::Font& font, unsigned characterSize);
+
+// How text is fitted into a box: the sizes to try, largest first, and the box's width and height
+struct TextWrapStyle {
+    std::vector<GlyphMetrics> sizes;
+    float width = 0;
+    float height = 0;
+};
+
+// A text broken into lines at the largest size that fits
+struct TextLayout {
+    std::string text;             // With '\n' at the line breaks, ready for sf::Text
+    unsigned characterSize = 0;
+    std::size_t lineCount = 0;
+    float height = 0;             // lineCount lines at the size's line spacing
+};
+
+// Function to wrap text at spaces to the style's width, at the largest size whose lines fit the
+// style's height. A word wider than a line is split between characters; text that does not fit at
+// any size uses the smallest, with as many lines as it takes.
+TextLayout layoutText(std::string_view text, const TextWrapStyle& style);
+
+// Layouts of a deck's questions, keyed by the text shown: every acronym and every full name
+using DeckLayouts = std::unordered_map<std::string, TextLayout>;
+
+// Function to lay out every acronym and full name of a deck. It only reads the style's tables, so
+// it runs in the background with the rest of a round's preparation.
+std::shared_ptr<const DeckLayouts> layoutDeck(const AcronymMap& acronyms, const TextWrapStyle& style);
+
+// Function to show prefix, value and suffix in an sf::Text, composed in label, which the caller keeps
+// for that text. The label and the text's own copy keep their memory from one change to the next,
+// so once they have held the longest string shown, changing it allocates nothing. Bytes are taken
+// as Latin-1, which matches what setString(std::string) does for the game's ASCII.
+void setTextLabel(sf::Text& text, sf::String& label, std::string_view prefix, std::string_view value, std::string_view suffix = {});
@@ -0,0 +1,59 @@
+#include "TitleScene.h"
+#include "TextLayout.h"
+
+TitleScene::TitleScene(const sf::Font& font) {
+    // Title text
+    title = sf::Text("Acronym Invaders!", font, 50);
+    title.setFillColor(sf::Color::Yellow);
+    title.setPosition(200, 100);
+
+    // Game mode options
+    mode1 = sf::Text("1. Acronym Mode", font, 30);
+    mode1.setFillColor(sf::Color::White);
+    mode1.setPosition(300, 250);
+
+    mode2 = sf::Text("2. Term Mode", font, 30);
+    mode2.setFillColor(sf::Color::White);
+    mode2.setPosition(300, 300);
+
+    mode3 = sf::Text("3. Challenge Mode", font, 30);
+    mode3.setFillColor(sf::Color::White);
+    mode3.setPosition(300, 350);
+
+    exit = sf::Text("Press 'Q' to Quit", font, 24);
+    exit.setFillColor(sf::Color::White);
+    exit.setPosition(300, 400);
+
+    // Tag filter, e.g. "Crypto AND NOT Wireless"
+    filterText = sf::Text("", font, 24);
+    filterText.setFillColor(sf::Color::White);
+    filterText.setPosition(100, 450);
+}
+
+void TitleScene::setFilter(const std::string& deckFilter, bool editing) {
+    if (filterSet && deckFilter == shownFilter && editing == shownEditing) {
+        return;
+    }
+    filterSet = true;
+    shownFilter = deckFilter;
+    shownEditing = editing;
+
+    if (editing) {
+        setTextLabel(filterText, filterLabel, "Filter: ", deckFilter, "_");
+    }
+    else {
+        setTextLabel(filterText, filterLabel, "F. Filter: ", deckFilter.empty() ? "All acronyms" : deckFilter);
+    }
+}
+
+void TitleScene::draw(RenderBackend& backend, BackgroundCache& background, const sf::Texture* backgroundTexture) {
+    if (backgroundTexture) {
+        background.draw(backend, backgroundTexture); // Drawn from the first frame it is ready
+    }
+    backend.draw(title); // Draw title text
+    backend.draw(mode1); // Draw mode 1 text
+    backend.draw(mode2); // Draw mode 2 text
+    backend.draw(mode3); // Draw mode 3 text
+    backend.draw(exit);  // Draw ext text
+    backend.draw(filterText);
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "RenderBackend.h"
+#include "ScreenLayout.h"
+#include <string>
+
+// What the title screen draws: the game's name, the mode choices and the tag filter
+class TitleScene {
+public:
+    explicit TitleScene(const sf::Font& font);
+
+    // Function to show the tag filter, with a cursor while it is being typed; the label is only
+    // rebuilt when the filter changes
+    void setFilter(const std::string& deckFilter, bool editing);
+
+    // Function to draw the title screen; the background is left out until its texture is loaded.
+    // The caller clears and displays the backend.
+    void draw(RenderBackend& backend, BackgroundCache& background, const sf::Texture* backgroundTexture);
+
+private:
+    sf::Text title;
+    sf::Text mode1;
+    sf::Text mode2;
+    sf::Text mode3;
+    sf::Text exit;
+    sf::Text filterText;
+
+    // What filterText shows, once it is set
+    bool filterSet = false;
+    std::string shownFilter;
+    bool shownEditing = false;
+    sf::String filterLabel; // Where the label is composed, reused on every change
+};
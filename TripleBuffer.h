@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer for handing whole values from one writer thread to one reader thread.
+// The writer fills writeBuffer() and calls publish(); the reader calls update() and then
+// reads readBuffer(). Neither side ever waits, and the reader always sees the newest
+// complete value that has been published.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Writer side
+    T& writeBuffer() {
+        return buffers[backIndex];
+    }
+
+    void publish() {
+        const std::uint8_t previous = middleIndex.exchange(static_cast<std::uint8_t>(backIndex | freshBit), std::memory_order_acq_rel);
+        backIndex = previous & indexMask;
+    }
+
+    // Reader side: swaps in the newest published value, returns false if nothing new arrived
+    bool update() {
+        if ((middleIndex.load(std::memory_order_relaxed) & freshBit) == 0) {
+            return false;
+        }
+        const std::uint8_t previous = middleIndex.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & indexMask;
+        return true;
+    }
+
+    const T& readBuffer() const {
+        return buffers[frontIndex];
+    }
+
+private:
+    static constexpr std::uint8_t indexMask = 0x3;
+    static constexpr std::uint8_t freshBit = 0x4;
+
+    T buffers[3];
+    std::uint8_t frontIndex = 0;                 // Owned by the reader
+    std::uint8_t backIndex = 2;                  // Owned by the writer
+    std::atomic<std::uint8_t> middleIndex{ 1 };  // Shared slot plus "fresh" flag
+};
@@ -0,0 +1,43 @@
+#include "UiChrome.h"
+
+UiChrome::UiChrome()
+    : buffer(sf::Triangles, sf::VertexBuffer::Static) {
+}
+
+void UiChrome::addRectangle(const sf::FloatRect& rect, sf::Color color) {
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+    for (const sf::Vector2f& corner : { topLeft, topRight, bottomLeft, topRight, bottomRight, bottomLeft }) {
+        vertices.emplace_back(corner, color);
+    }
+    uploaded = false;
+}
+
+void UiChrome::addFrame(const sf::FloatRect& rect, float thickness, sf::Color color) {
+    float left = rect.left - thickness;
+    float top = rect.top - thickness;
+    float width = rect.width + 2 * thickness;
+    addRectangle(sf::FloatRect(left, top, width, thickness), color);                                  // Top
+    addRectangle(sf::FloatRect(left, rect.top + rect.height, width, thickness), color);               // Bottom
+    addRectangle(sf::FloatRect(left, rect.top, thickness, rect.height), color);                       // Left
+    addRectangle(sf::FloatRect(rect.left + rect.width, rect.top, thickness, rect.height), color);     // Right
+}
+
+void UiChrome::build(bool upload) {
+    uploaded = upload && sf::VertexBuffer::isAvailable() && buffer.create(vertices.size()) &&
+        (vertices.empty() || buffer.update(vertices.data()));
+}
+
+void UiChrome::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    if (vertices.empty()) {
+        return;
+    }
+    if (uploaded) {
+        target.draw(buffer, states);
+    }
+    else {
+        target.draw(vertices.data(), vertices.size(), sf::Triangles, states);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// The static panels of a screen (the translucent boxes behind text, frames) in one vertex buffer.
+//
+// Drawn as sf::RectangleShapes, every panel is its own draw call, an outlined one two, and a shape
+// rebuilt each frame is tessellated again each frame. Here the panels are added once as triangles
+// in layout units, uploaded once to a static vertex buffer, and the whole screen's chrome is one
+// draw call. Where the GL driver has no vertex buffers the same triangles are drawn from memory,
+// still in one call.
+class UiChrome : public sf::Drawable {
+public:
+    UiChrome();
+
+    // Functions to add a filled rectangle, or a frame drawn outside the rectangle like an sf::Shape outline
+    void addRectangle(const sf::FloatRect& rect, sf::Color color);
+    void addFrame(const sf::FloatRect& rect, float thickness, sf::Color color);
+
+    // Function to upload the panels added so far; call once they are all added. Without upload
+    // (no GL context, e.g. the null render backend) they stay in memory only.
+    void build(bool upload = true);
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    std::vector<sf::Vertex> vertices;
+    sf::VertexBuffer buffer;
+    bool uploaded = false;
+};
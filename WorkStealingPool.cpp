@@ -0,0 +1,101 @@
+#include "WorkStealingPool.h"
+
+namespace {
+    // Which pool and worker the current thread belongs to, if any
+    thread_local const WorkStealingPool* currentPool = nullptr;
+    thread_local unsigned currentWorker = 0;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    unsigned index = (currentPool == this) ? currentWorker : nextWorker++ % size();
+
+    pendingTasks++;
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    queuedTasks++;
+
+    // Taking the lock orders this notify after a sleeping worker's predicate check
+    { std::lock_guard<std::mutex> lock(stateMutex); }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this]() { return pendingTasks == 0; });
+}
+
+bool WorkStealingPool::popLocal(unsigned index, std::function<void()>& task) {
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned thief, std::function<void()>& task) {
+    for (unsigned offset = 1; offset < size(); ++offset) {
+        Worker& victim = *workers[(thief + offset) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queuedTasks--;
+            task();
+
+            if (--pendingTasks == 0) {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0) {
+            return;
+        }
+    }
+}
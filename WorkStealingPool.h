@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool where every worker has its own task deque.
+// A worker runs its own newest task first and, when it runs dry, steals the oldest task
+// from another worker, so uneven tasks (long and short sessions, big and small files)
+// still keep every core busy.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned threadCount = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Queues a task; tasks submitted from inside a worker go to that worker's own deque
+    void submit(std::function<void()> task);
+
+    // Blocks until every submitted task has finished
+    void wait();
+
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool popLocal(unsigned index, std::function<void()>& task);
+    bool steal(unsigned thief, std::function<void()>& task);
+    void workerLoop(unsigned index);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::atomic<std::size_t> queuedTasks{ 0 };   // Sitting in a deque
+    std::atomic<std::size_t> pendingTasks{ 0 };  // Submitted but not finished
+    std::atomic<unsigned> nextWorker{ 0 };       // Round-robin target for outside submissions
+
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    bool stopping = false;
+};